@@ -52,47 +52,111 @@
 **************************************************************************/
 
 #include "bme280.h"
-static struct bme280_t *p_bme280; /**< pointer to BME280 */
 
 /*!
- *	@brief This function is used for initialize
- *	the bus read and bus write functions
- *  and assign the chip id and I2C address of the BME280 sensor
- *	chip id is read in the register 0xD0 bit from 0 to 7
+ *	@brief Reads the control humidity, control measurement
+ *	and configuration registers into the device structure
+ *	with one burst read of the registers 0xF2 to 0xF5
  *
- *	 @param bme280 structure pointer.
+ *	@param p_bme280 : pointer to the bme280 device structure
  *
- *	@note While changing the parameter of the bme280_t
- *	@note consider the following point:
- *	Changing the reference value of the parameter
- *	will changes the local copy or local reference
- *	make sure your changes will not
- *	affect the reference value of the parameter
- *	(Better case don't change the reference value of the parameter)
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ */
+static BME280_RETURN_FUNCTION_TYPE bme280_read_ctrl_registers(
+struct bme280_t *p_bme280)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 a_data_u8[BME280_CTRL_REGISTERS_SIZE] = {
+	BME280_INIT_VALUE, BME280_INIT_VALUE,
+	BME280_INIT_VALUE, BME280_INIT_VALUE};
+
+	com_rslt = p_bme280->BME280_BUS_READ_FUNC(
+	p_bme280->dev_addr, BME280_CTRL_HUMIDITY_REG,
+	a_data_u8, BME280_CTRL_REGISTERS_DATA_LENGTH);
+	if (com_rslt == SUCCESS) {
+		p_bme280->ctrl_hum_reg =
+		a_data_u8[BME280_CTRL_REGISTERS_HUMIDITY_BYTE];
+		p_bme280->ctrl_meas_reg =
+		a_data_u8[BME280_CTRL_REGISTERS_MEAS_BYTE];
+		p_bme280->config_reg =
+		a_data_u8[BME280_CTRL_REGISTERS_CONFIG_BYTE];
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief Updates the cached control registers after a write.
+ *	In shadow mode the written values are stored as they are,
+ *	otherwise the registers are read back from the sensor.
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *	@param v_ctrl_hum_u8 : value written to the register 0xF2
+ *	@param v_ctrl_meas_u8 : value written to the register 0xF4
+ *	@param v_config_u8 : value written to the register 0xF5
  *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ */
+static BME280_RETURN_FUNCTION_TYPE bme280_update_ctrl_registers(
+struct bme280_t *p_bme280, u8 v_ctrl_hum_u8,
+u8 v_ctrl_meas_u8, u8 v_config_u8)
+{
+	if (p_bme280->shadow_mode != BME280_SHADOW_MODE_ENABLE)
+		return bme280_read_ctrl_registers(p_bme280);
+
+	p_bme280->ctrl_hum_reg = v_ctrl_hum_u8;
+	p_bme280->ctrl_meas_reg = v_ctrl_meas_u8;
+	p_bme280->config_reg = v_config_u8;
+	return SUCCESS;
+}
+/*!
+ *	@brief Gets the power mode a setter has to leave.
+ *	In shadow mode it is taken from the cached control
+ *	measurement register, a forced conversion counts as
+ *	sleep because the sensor returns there by itself.
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *	@param v_power_mode_u8 : The value of power mode
  *
  *	@return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
+ */
+static BME280_RETURN_FUNCTION_TYPE bme280_get_prev_power_mode(
+struct bme280_t *p_bme280, u8 *v_power_mode_u8)
+{
+	if (p_bme280->shadow_mode != BME280_SHADOW_MODE_ENABLE)
+		return bme280_get_power_mode(p_bme280, v_power_mode_u8);
+
+	*v_power_mode_u8 = BME280_GET_BITSLICE(p_bme280->ctrl_meas_reg,
+	BME280_CTRL_MEAS_REG_POWER_MODE);
+	if (*v_power_mode_u8 != BME280_NORMAL_MODE)
+		*v_power_mode_u8 = BME280_SLEEP_MODE;
+	return SUCCESS;
+}
+
+/*!
+ *	@brief This function reads the chip id, retrying while the
+ *	sensor is still powering up, and stores it in the device
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
+ *	@return BME280_CHIP_ID_READ_SUCCESS or BME280_CHIP_ID_READ_FAIL
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280)
+static BME280_RETURN_FUNCTION_TYPE bme280_read_chip_id(
+struct bme280_t *p_bme280)
 {
-	/* used to return the communication result*/
-	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
 	u8 v_data_u8 = BME280_INIT_VALUE;
 	u8 v_chip_id_read_count = BME280_CHIP_ID_READ_COUNT;
 
-	/* assign BME280 ptr */
-	p_bme280 = bme280;
-
 	while (v_chip_id_read_count > 0) {
 
 		/* read Chip Id */
-		com_rslt = p_bme280->BME280_BUS_READ_FUNC(p_bme280->dev_addr,
+		p_bme280->BME280_BUS_READ_FUNC(p_bme280->dev_addr,
 				BME280_CHIP_ID_REG, &v_data_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
 		/* Check for the correct chip id */
@@ -103,15 +167,58 @@ BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280)
 		facilitate the proper reading of the chip ID */
 		p_bme280->delay_msec(BME280_REGISTER_READ_DELAY);
 	}
-	/*assign chip ID to the global structure*/
+	/*assign chip ID to the device structure*/
 	p_bme280->chip_id = v_data_u8;
 	/*com_rslt status of chip ID read*/
-	com_rslt = (v_chip_id_read_count == BME280_INIT_VALUE) ?
+	return (v_chip_id_read_count == BME280_INIT_VALUE) ?
 			BME280_CHIP_ID_READ_FAIL : BME280_CHIP_ID_READ_SUCCESS;
+}
+/*!
+ *	@brief This function is used for initialize
+ *	the bus read and bus write functions
+ *  and assign the chip id and I2C address of the BME280 sensor
+ *	chip id is read in the register 0xD0 bit from 0 to 7
+ *	and the registers 0xF2 to 0xF5 are read into the cached
+ *	control registers
+ *
+ *	 @param p_bme280 : pointer to the bme280 device structure
+ *
+ *	@note With shadow_mode set to BME280_SHADOW_MODE_ENABLE the
+ *	setters trust the cached control registers and skip the read
+ *	back; the registers must then only be changed through this driver
+ *
+ *	@note While changing the parameter of the bme280_t
+ *	@note consider the following point:
+ *	Changing the reference value of the parameter
+ *	will changes the local copy or local reference
+ *	make sure your changes will not
+ *	affect the reference value of the parameter
+ *	(Better case don't change the reference value of the parameter)
+ *
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *p_bme280)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+
+	/* check the p_bme280 structure pointer as NULL*/
+	if (p_bme280 == BME280_NULL)
+		return E_BME280_NULL_PTR;
 
+	com_rslt = bme280_read_chip_id(p_bme280);
 	if (com_rslt == BME280_CHIP_ID_READ_SUCCESS) {
 		/* readout bme280 calibparam structure */
-		com_rslt += bme280_get_calib_param();
+		com_rslt += bme280_get_calib_param(p_bme280);
+		/* prime the cached control registers */
+		com_rslt += bme280_read_ctrl_registers(p_bme280);
 	}
 	return com_rslt;
 }
@@ -122,6 +229,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280)
  *	@note 0xFB -> LSB -> bit from 0 to 7
  *	@note 0xFC -> LSB -> bit from 4 to 7
  *
+ * @param p_bme280 : pointer to the bme280 device structure
  * @param v_uncomp_temperature_s32 : The value of uncompensated temperature
  *
  *
@@ -133,7 +241,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_temperature(
-s32 *v_uncomp_temperature_s32)
+struct bme280_t *p_bme280, s32 *v_uncomp_temperature_s32)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -164,19 +272,13 @@ s32 *v_uncomp_temperature_s32)
 	return com_rslt;
 }
 /*!
- * @brief Reads actual temperature from uncompensated temperature
- * @note Returns the value in 0.01 degree Centigrade
- * Output value of "5123" equals 51.23 DegC.
- *
- *
- *
- *  @param  v_uncomp_temperature_s32 : value of uncompensated temperature
- *
- *
- *  @return Returns the actual temperature
- *
-*/
-s32 bme280_compensate_temperature_int32(s32 v_uncomp_temperature_s32)
+ * @brief Integer compensation kernels shared by the single value
+ * functions and the batch function. They take the calibration and
+ * t_fine explicitly instead of through the device structure.
+ */
+static inline s32 bme280_temperature_int32_kernel(
+const struct bme280_calibration_param_t *p_cal,
+s32 v_uncomp_temperature_s32, s32 *v_t_fine_s32)
 {
 	s32 v_x1_u32r = BME280_INIT_VALUE;
 	s32 v_x2_u32r = BME280_INIT_VALUE;
@@ -186,32 +288,154 @@ s32 bme280_compensate_temperature_int32(s32 v_uncomp_temperature_s32)
 	v_x1_u32r  =
 	((((v_uncomp_temperature_s32
 	>> BME280_SHIFT_BIT_POSITION_BY_03_BITS) -
-	((s32)p_bme280->cal_param.dig_T1
+	((s32)p_cal->dig_T1
 	<< BME280_SHIFT_BIT_POSITION_BY_01_BIT))) *
-	((s32)p_bme280->cal_param.dig_T2)) >>
+	((s32)p_cal->dig_T2)) >>
 	BME280_SHIFT_BIT_POSITION_BY_11_BITS;
 	/* calculate x2*/
 	v_x2_u32r  = (((((v_uncomp_temperature_s32
 	>> BME280_SHIFT_BIT_POSITION_BY_04_BITS) -
-	((s32)p_bme280->cal_param.dig_T1))
+	((s32)p_cal->dig_T1))
 	* ((v_uncomp_temperature_s32 >> BME280_SHIFT_BIT_POSITION_BY_04_BITS) -
-	((s32)p_bme280->cal_param.dig_T1)))
+	((s32)p_cal->dig_T1)))
 	>> BME280_SHIFT_BIT_POSITION_BY_12_BITS) *
-	((s32)p_bme280->cal_param.dig_T3))
+	((s32)p_cal->dig_T3))
 	>> BME280_SHIFT_BIT_POSITION_BY_14_BITS;
 	/* calculate t_fine*/
-	p_bme280->cal_param.t_fine = v_x1_u32r + v_x2_u32r;
+	*v_t_fine_s32 = v_x1_u32r + v_x2_u32r;
 	/* calculate temperature*/
-	temperature  = (p_bme280->cal_param.t_fine * 5 + 128)
+	temperature  = (*v_t_fine_s32 * 5 + 128)
 	>> BME280_SHIFT_BIT_POSITION_BY_08_BITS;
 	return temperature;
 }
+static inline u32 bme280_pressure_int32_kernel(
+const struct bme280_calibration_param_t *p_cal,
+s32 v_t_fine_s32, s32 v_uncomp_pressure_s32)
+{
+	s32 v_x1_u32 = BME280_INIT_VALUE;
+	s32 v_x2_u32 = BME280_INIT_VALUE;
+	u32 v_pressure_u32 = BME280_INIT_VALUE;
+
+	/* calculate x1*/
+	v_x1_u32 = (v_t_fine_s32
+	>> BME280_SHIFT_BIT_POSITION_BY_01_BIT) - (s32)64000;
+	/* calculate x2*/
+	v_x2_u32 = (((v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS)
+	* (v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS)
+	) >> BME280_SHIFT_BIT_POSITION_BY_11_BITS)
+	* ((s32)p_cal->dig_P6);
+	/* calculate x2*/
+	v_x2_u32 = v_x2_u32 + ((v_x1_u32 *
+	((s32)p_cal->dig_P5))
+	<< BME280_SHIFT_BIT_POSITION_BY_01_BIT);
+	/* calculate x2*/
+	v_x2_u32 = (v_x2_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS) +
+	(((s32)p_cal->dig_P4)
+	<< BME280_SHIFT_BIT_POSITION_BY_16_BITS);
+	/* calculate x1*/
+	v_x1_u32 = (((p_cal->dig_P3 *
+	(((v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS) *
+	(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS))
+	>> BME280_SHIFT_BIT_POSITION_BY_13_BITS))
+	>> BME280_SHIFT_BIT_POSITION_BY_03_BITS) +
+	((((s32)p_cal->dig_P2) *
+	v_x1_u32) >> BME280_SHIFT_BIT_POSITION_BY_01_BIT))
+	>> BME280_SHIFT_BIT_POSITION_BY_18_BITS;
+	/* calculate x1*/
+	v_x1_u32 = ((((32768 + v_x1_u32)) *
+	((s32)p_cal->dig_P1))
+	>> BME280_SHIFT_BIT_POSITION_BY_15_BITS);
+	/* calculate pressure*/
+	v_pressure_u32 =
+	(((u32)(((s32)1048576) - v_uncomp_pressure_s32)
+	- (v_x2_u32 >> BME280_SHIFT_BIT_POSITION_BY_12_BITS))) * 3125;
+	/* Avoid exception caused by division by zero */
+	if (v_x1_u32 == BME280_INIT_VALUE)
+		return BME280_INVALID_DATA;
+	if (v_pressure_u32 < 0x80000000) {
+		v_pressure_u32 = (v_pressure_u32
+		<< BME280_SHIFT_BIT_POSITION_BY_01_BIT) /
+		((u32)v_x1_u32);
+	} else {
+		v_pressure_u32 = (v_pressure_u32
+		/ (u32)v_x1_u32) * 2;
+	}
+
+	v_x1_u32 = (((s32)p_cal->dig_P9) *
+	((s32)(((v_pressure_u32 >> BME280_SHIFT_BIT_POSITION_BY_03_BITS)
+	* (v_pressure_u32 >> BME280_SHIFT_BIT_POSITION_BY_03_BITS))
+	>> BME280_SHIFT_BIT_POSITION_BY_13_BITS)))
+	>> BME280_SHIFT_BIT_POSITION_BY_12_BITS;
+	v_x2_u32 = (((s32)(v_pressure_u32
+	>> BME280_SHIFT_BIT_POSITION_BY_02_BITS)) *
+	((s32)p_cal->dig_P8))
+	>> BME280_SHIFT_BIT_POSITION_BY_13_BITS;
+	v_pressure_u32 = (u32)((s32)v_pressure_u32 +
+	((v_x1_u32 + v_x2_u32 + p_cal->dig_P7)
+	>> BME280_SHIFT_BIT_POSITION_BY_04_BITS));
+
+	return v_pressure_u32;
+}
+static inline u32 bme280_humidity_int32_kernel(
+const struct bme280_calibration_param_t *p_cal,
+s32 v_t_fine_s32, s32 v_uncomp_humidity_s32)
+{
+	s32 v_x1_u32 = BME280_INIT_VALUE;
+
+	/* calculate x1*/
+	v_x1_u32 = (v_t_fine_s32 - ((s32)76800));
+	/* calculate x1*/
+	v_x1_u32 = (((((v_uncomp_humidity_s32
+	<< BME280_SHIFT_BIT_POSITION_BY_14_BITS) -
+	(((s32)p_cal->dig_H4)
+	<< BME280_SHIFT_BIT_POSITION_BY_20_BITS) -
+	(((s32)p_cal->dig_H5) * v_x1_u32)) +
+	((s32)16384)) >> BME280_SHIFT_BIT_POSITION_BY_15_BITS)
+	* (((((((v_x1_u32 *
+	((s32)p_cal->dig_H6))
+	>> BME280_SHIFT_BIT_POSITION_BY_10_BITS) *
+	(((v_x1_u32 * ((s32)p_cal->dig_H3))
+	>> BME280_SHIFT_BIT_POSITION_BY_11_BITS) + ((s32)32768)))
+	>> BME280_SHIFT_BIT_POSITION_BY_10_BITS) + ((s32)2097152)) *
+	((s32)p_cal->dig_H2) + 8192) >> 14));
+	v_x1_u32 = (v_x1_u32 - (((((v_x1_u32
+	>> BME280_SHIFT_BIT_POSITION_BY_15_BITS) *
+	(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_15_BITS))
+	>> BME280_SHIFT_BIT_POSITION_BY_07_BITS) *
+	((s32)p_cal->dig_H1))
+	>> BME280_SHIFT_BIT_POSITION_BY_04_BITS));
+	v_x1_u32 = (v_x1_u32 < 0 ? 0 : v_x1_u32);
+	v_x1_u32 = (v_x1_u32 > 419430400 ?
+	419430400 : v_x1_u32);
+	return (u32)(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_12_BITS);
+}
+/*!
+ * @brief Reads actual temperature from uncompensated temperature
+ * @note Returns the value in 0.01 degree Centigrade
+ * Output value of "5123" equals 51.23 DegC.
+ *
+ *
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param  v_uncomp_temperature_s32 : value of uncompensated temperature
+ *
+ *
+ *  @return Returns the actual temperature
+ *
+*/
+s32 bme280_compensate_temperature_int32(
+struct bme280_t *p_bme280, s32 v_uncomp_temperature_s32)
+{
+	return bme280_temperature_int32_kernel(&p_bme280->cal_param,
+	v_uncomp_temperature_s32, &p_bme280->cal_param.t_fine);
+}
 /*!
  * @brief Reads actual temperature from uncompensated temperature
  * @note Returns the value with 500LSB/DegC centred around 24 DegC
  * output value of "5123" equals(5123/500)+24 = 34.246DegC
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncomp_temperature_s32: value of uncompensated temperature
  *
  *
@@ -220,11 +444,11 @@ s32 bme280_compensate_temperature_int32(s32 v_uncomp_temperature_s32)
  *
 */
 s16 bme280_compensate_temperature_int32_sixteen_bit_output(
-s32 v_uncomp_temperature_s32)
+struct bme280_t *p_bme280, s32 v_uncomp_temperature_s32)
 {
 	s16 temperature = BME280_INIT_VALUE;
 
-	bme280_compensate_temperature_int32(
+	bme280_compensate_temperature_int32(p_bme280,
 	v_uncomp_temperature_s32);
 	temperature  = (s16)((((
 	p_bme280->cal_param.t_fine - 122880) * 25) + 128)
@@ -241,6 +465,7 @@ s32 v_uncomp_temperature_s32)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_uncomp_pressure_s32 : The value of uncompensated pressure
  *
  *
@@ -252,7 +477,7 @@ s32 v_uncomp_temperature_s32)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_pressure(
-s32 *v_uncomp_pressure_s32)
+struct bme280_t *p_bme280, s32 *v_uncomp_pressure_s32)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -289,6 +514,7 @@ s32 *v_uncomp_pressure_s32)
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncomp_pressure_s32 : value of uncompensated pressure
  *
  *
@@ -296,77 +522,11 @@ s32 *v_uncomp_pressure_s32)
  *  @return Return the actual pressure output as u32
  *
 */
-u32 bme280_compensate_pressure_int32(s32 v_uncomp_pressure_s32)
+u32 bme280_compensate_pressure_int32(
+struct bme280_t *p_bme280, s32 v_uncomp_pressure_s32)
 {
-	s32 v_x1_u32 = BME280_INIT_VALUE;
-	s32 v_x2_u32 = BME280_INIT_VALUE;
-	u32 v_pressure_u32 = BME280_INIT_VALUE;
-
-	/* calculate x1*/
-	v_x1_u32 = (((s32)p_bme280->cal_param.t_fine)
-	>> BME280_SHIFT_BIT_POSITION_BY_01_BIT) - (s32)64000;
-	/* calculate x2*/
-	v_x2_u32 = (((v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS)
-	* (v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS)
-	) >> BME280_SHIFT_BIT_POSITION_BY_11_BITS)
-	* ((s32)p_bme280->cal_param.dig_P6);
-	/* calculate x2*/
-	v_x2_u32 = v_x2_u32 + ((v_x1_u32 *
-	((s32)p_bme280->cal_param.dig_P5))
-	<< BME280_SHIFT_BIT_POSITION_BY_01_BIT);
-	/* calculate x2*/
-	v_x2_u32 = (v_x2_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS) +
-	(((s32)p_bme280->cal_param.dig_P4)
-	<< BME280_SHIFT_BIT_POSITION_BY_16_BITS);
-	/* calculate x1*/
-	v_x1_u32 = (((p_bme280->cal_param.dig_P3 *
-	(((v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS) *
-	(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_02_BITS))
-	>> BME280_SHIFT_BIT_POSITION_BY_13_BITS))
-	>> BME280_SHIFT_BIT_POSITION_BY_03_BITS) +
-	((((s32)p_bme280->cal_param.dig_P2) *
-	v_x1_u32) >> BME280_SHIFT_BIT_POSITION_BY_01_BIT))
-	>> BME280_SHIFT_BIT_POSITION_BY_18_BITS;
-	/* calculate x1*/
-	v_x1_u32 = ((((32768 + v_x1_u32)) *
-	((s32)p_bme280->cal_param.dig_P1))
-	>> BME280_SHIFT_BIT_POSITION_BY_15_BITS);
-	/* calculate pressure*/
-	v_pressure_u32 =
-	(((u32)(((s32)1048576) - v_uncomp_pressure_s32)
-	- (v_x2_u32 >> BME280_SHIFT_BIT_POSITION_BY_12_BITS))) * 3125;
-	if (v_pressure_u32
-	< 0x80000000)
-		/* Avoid exception caused by division by zero */
-		if (v_x1_u32 != BME280_INIT_VALUE)
-			v_pressure_u32 =
-			(v_pressure_u32
-			<< BME280_SHIFT_BIT_POSITION_BY_01_BIT) /
-			((u32)v_x1_u32);
-		else
-			return BME280_INVALID_DATA;
-	else
-		/* Avoid exception caused by division by zero */
-		if (v_x1_u32 != BME280_INIT_VALUE)
-			v_pressure_u32 = (v_pressure_u32
-			/ (u32)v_x1_u32) * 2;
-		else
-			return BME280_INVALID_DATA;
-
-		v_x1_u32 = (((s32)p_bme280->cal_param.dig_P9) *
-		((s32)(((v_pressure_u32 >> BME280_SHIFT_BIT_POSITION_BY_03_BITS)
-		* (v_pressure_u32 >> BME280_SHIFT_BIT_POSITION_BY_03_BITS))
-		>> BME280_SHIFT_BIT_POSITION_BY_13_BITS)))
-		>> BME280_SHIFT_BIT_POSITION_BY_12_BITS;
-		v_x2_u32 = (((s32)(v_pressure_u32
-		>> BME280_SHIFT_BIT_POSITION_BY_02_BITS)) *
-		((s32)p_bme280->cal_param.dig_P8))
-		>> BME280_SHIFT_BIT_POSITION_BY_13_BITS;
-		v_pressure_u32 = (u32)((s32)v_pressure_u32 +
-		((v_x1_u32 + v_x2_u32 + p_bme280->cal_param.dig_P7)
-		>> BME280_SHIFT_BIT_POSITION_BY_04_BITS));
-
-	return v_pressure_u32;
+	return bme280_pressure_int32_kernel(&p_bme280->cal_param,
+	p_bme280->cal_param.t_fine, v_uncomp_pressure_s32);
 }
 /*!
  *	@brief This API is used to read uncompensated humidity.
@@ -376,6 +536,7 @@ u32 bme280_compensate_pressure_int32(s32 v_uncomp_pressure_s32)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_uncomp_humidity_s32 : The value of uncompensated humidity
  *
  *
@@ -387,7 +548,7 @@ u32 bme280_compensate_pressure_int32(s32 v_uncomp_pressure_s32)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_humidity(
-s32 *v_uncomp_humidity_s32)
+struct bme280_t *p_bme280, s32 *v_uncomp_humidity_s32)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -421,41 +582,100 @@ s32 *v_uncomp_humidity_s32)
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_uncomp_humidity_s32: value of uncompensated humidity
  *
  *  @return Return the actual relative humidity output as u32
  *
 */
-u32 bme280_compensate_humidity_int32(s32 v_uncomp_humidity_s32)
+u32 bme280_compensate_humidity_int32(
+struct bme280_t *p_bme280, s32 v_uncomp_humidity_s32)
 {
-	s32 v_x1_u32 = BME280_INIT_VALUE;
+	return bme280_humidity_int32_kernel(&p_bme280->cal_param,
+	p_bme280->cal_param.t_fine, v_uncomp_humidity_s32);
+}
+/*!
+ * @brief Compensates arrays of uncompensated temperature,
+ * pressure and humidity with the 32 bit integer formulas.
+ * t_fine is carried from the temperature to the pressure and
+ * humidity of the same index, the device is not modified.
+ * The samples are processed in chunks of
+ * BME280_BATCH_CHUNK_SIZE with one plain loop per quantity,
+ * so every loop runs one inlined kernel over contiguous
+ * arrays. The loops are not vectorized, the pressure
+ * kernel divides and returns early on invalid data.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param a_uncomp_temperature_s32 : uncompensated temperatures
+ *  @param a_uncomp_pressure_s32 : uncompensated pressures
+ *  or BME280_NULL
+ *  @param a_uncomp_humidity_s32 : uncompensated humidities
+ *  or BME280_NULL
+ *  @param a_temperature_s32 : temperatures in 0.01 DegC
+ *  @param a_pressure_u32 : pressures in Pa, BME280_NULL if
+ *  a_uncomp_pressure_s32 is BME280_NULL
+ *  @param a_humidity_u32 : humidities in Q22.10 %rH, BME280_NULL
+ *  if a_uncomp_humidity_s32 is BME280_NULL
+ *  @param v_count_u32 : number of samples in every array
+ *
+ *	@return results of the parameter check
+ *	@retval 0 -> Success
+ *	@retval -127 -> Missing array
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_compensate_int32_batch(
+const struct bme280_t *p_bme280,
+const s32 *a_uncomp_temperature_s32,
+const s32 *a_uncomp_pressure_s32,
+const s32 *a_uncomp_humidity_s32,
+s32 *a_temperature_s32, u32 *a_pressure_u32,
+u32 *a_humidity_u32, u32 v_count_u32)
+{
+	s32 a_t_fine_s32[BME280_BATCH_CHUNK_SIZE];
+	u32 v_offset_u32 = BME280_INIT_VALUE;
+	u32 v_chunk_u32 = BME280_INIT_VALUE;
+	u32 v_index_u32 = BME280_INIT_VALUE;
+	const struct bme280_calibration_param_t *p_cal;
 
-	/* calculate x1*/
-	v_x1_u32 = (p_bme280->cal_param.t_fine - ((s32)76800));
-	/* calculate x1*/
-	v_x1_u32 = (((((v_uncomp_humidity_s32
-	<< BME280_SHIFT_BIT_POSITION_BY_14_BITS) -
-	(((s32)p_bme280->cal_param.dig_H4)
-	<< BME280_SHIFT_BIT_POSITION_BY_20_BITS) -
-	(((s32)p_bme280->cal_param.dig_H5) * v_x1_u32)) +
-	((s32)16384)) >> BME280_SHIFT_BIT_POSITION_BY_15_BITS)
-	* (((((((v_x1_u32 *
-	((s32)p_bme280->cal_param.dig_H6))
-	>> BME280_SHIFT_BIT_POSITION_BY_10_BITS) *
-	(((v_x1_u32 * ((s32)p_bme280->cal_param.dig_H3))
-	>> BME280_SHIFT_BIT_POSITION_BY_11_BITS) + ((s32)32768)))
-	>> BME280_SHIFT_BIT_POSITION_BY_10_BITS) + ((s32)2097152)) *
-	((s32)p_bme280->cal_param.dig_H2) + 8192) >> 14));
-	v_x1_u32 = (v_x1_u32 - (((((v_x1_u32
-	>> BME280_SHIFT_BIT_POSITION_BY_15_BITS) *
-	(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_15_BITS))
-	>> BME280_SHIFT_BIT_POSITION_BY_07_BITS) *
-	((s32)p_bme280->cal_param.dig_H1))
-	>> BME280_SHIFT_BIT_POSITION_BY_04_BITS));
-	v_x1_u32 = (v_x1_u32 < 0 ? 0 : v_x1_u32);
-	v_x1_u32 = (v_x1_u32 > 419430400 ?
-	419430400 : v_x1_u32);
-	return (u32)(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_12_BITS);
+	if (p_bme280 == BME280_NULL || a_uncomp_temperature_s32 == BME280_NULL
+	|| a_temperature_s32 == BME280_NULL)
+		return E_BME280_NULL_PTR;
+	if ((a_uncomp_pressure_s32 == BME280_NULL) !=
+	(a_pressure_u32 == BME280_NULL) ||
+	(a_uncomp_humidity_s32 == BME280_NULL) !=
+	(a_humidity_u32 == BME280_NULL))
+		return E_BME280_NULL_PTR;
+
+	p_cal = &p_bme280->cal_param;
+	for (v_offset_u32 = 0; v_offset_u32 < v_count_u32;
+	v_offset_u32 += v_chunk_u32) {
+		v_chunk_u32 = v_count_u32 - v_offset_u32;
+		if (v_chunk_u32 > BME280_BATCH_CHUNK_SIZE)
+			v_chunk_u32 = BME280_BATCH_CHUNK_SIZE;
+
+		for (v_index_u32 = 0; v_index_u32 < v_chunk_u32; v_index_u32++)
+			a_temperature_s32[v_offset_u32 + v_index_u32] =
+			bme280_temperature_int32_kernel(p_cal,
+			a_uncomp_temperature_s32[v_offset_u32 + v_index_u32],
+			&a_t_fine_s32[v_index_u32]);
+		if (a_uncomp_pressure_s32 != BME280_NULL)
+			for (v_index_u32 = 0; v_index_u32 < v_chunk_u32;
+			v_index_u32++)
+				a_pressure_u32[v_offset_u32 + v_index_u32] =
+				bme280_pressure_int32_kernel(p_cal,
+				a_t_fine_s32[v_index_u32],
+				a_uncomp_pressure_s32[v_offset_u32 +
+				v_index_u32]);
+		if (a_uncomp_humidity_s32 != BME280_NULL)
+			for (v_index_u32 = 0; v_index_u32 < v_chunk_u32;
+			v_index_u32++)
+				a_humidity_u32[v_offset_u32 + v_index_u32] =
+				bme280_humidity_int32_kernel(p_cal,
+				a_t_fine_s32[v_index_u32],
+				a_uncomp_humidity_s32[v_offset_u32 +
+				v_index_u32]);
+	}
+	return SUCCESS;
 }
 /*!
  * @brief Reads actual humidity from uncompensated humidity
@@ -465,6 +685,7 @@ u32 bme280_compensate_humidity_int32(s32 v_uncomp_humidity_s32)
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncomp_humidity_s32: value of uncompensated humidity
  *
  *
@@ -472,12 +693,12 @@ u32 bme280_compensate_humidity_int32(s32 v_uncomp_humidity_s32)
  *
 */
 u16 bme280_compensate_humidity_int32_sixteen_bit_output(
-s32 v_uncomp_humidity_s32)
+struct bme280_t *p_bme280, s32 v_uncomp_humidity_s32)
 {
 	u32 v_x1_u32 = BME280_INIT_VALUE;
 	u16 v_x2_u32 = BME280_INIT_VALUE;
 
-	v_x1_u32 =  bme280_compensate_humidity_int32(v_uncomp_humidity_s32);
+	v_x1_u32 =  bme280_compensate_humidity_int32(p_bme280, v_uncomp_humidity_s32);
 	v_x2_u32 = (u16)(v_x1_u32 >> BME280_SHIFT_BIT_POSITION_BY_01_BIT);
 	return v_x2_u32;
 }
@@ -488,6 +709,7 @@ s32 v_uncomp_humidity_s32)
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_uncomp_pressure_s32: The value of uncompensated pressure.
  *  @param  v_uncomp_temperature_s32: The value of uncompensated temperature
  *  @param  v_uncomp_humidity_s32: The value of uncompensated humidity.
@@ -501,7 +723,7 @@ s32 v_uncomp_humidity_s32)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_pressure_temperature_humidity(
-s32 *v_uncomp_pressure_s32,
+struct bme280_t *p_bme280, s32 *v_uncomp_pressure_s32,
 s32 *v_uncomp_temperature_s32, s32 *v_uncomp_humidity_s32)
 {
 	/* used to return the communication result*/
@@ -569,6 +791,7 @@ s32 *v_uncomp_temperature_s32, s32 *v_uncomp_humidity_s32)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param  v_pressure_u32 : The value of compensated pressure.
  *	@param  v_temperature_s32 : The value of compensated temperature.
  *	@param  v_humidity_u32 : The value of compensated humidity.
@@ -581,6 +804,7 @@ s32 *v_uncomp_temperature_s32, s32 *v_uncomp_humidity_s32)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_pressure_temperature_humidity(
+struct bme280_t *p_bme280,
 u32 *v_pressure_u32, s32 *v_temperature_s32, u32 *v_humidity_u32)
 {
 	/* used to return the communication result*/
@@ -595,20 +819,96 @@ u32 *v_pressure_u32, s32 *v_temperature_s32, u32 *v_humidity_u32)
 			/* read the uncompensated pressure,
 			temperature and humidity*/
 			com_rslt =
-			bme280_read_uncomp_pressure_temperature_humidity(
+			bme280_read_uncomp_pressure_temperature_humidity(p_bme280,
 			&v_uncomp_pressure_s32, &v_uncom_temperature_s32,
 			&v_uncom_humidity_s32);
 			/* read the true pressure, temperature and humidity*/
 			*v_temperature_s32 =
-			bme280_compensate_temperature_int32(
+			bme280_compensate_temperature_int32(p_bme280,
 			v_uncom_temperature_s32);
-			*v_pressure_u32 = bme280_compensate_pressure_int32(
+			*v_pressure_u32 = bme280_compensate_pressure_int32(p_bme280,
 			v_uncomp_pressure_s32);
-			*v_humidity_u32 = bme280_compensate_humidity_int32(
+			*v_humidity_u32 = bme280_compensate_humidity_int32(p_bme280,
 			v_uncom_humidity_s32);
 		}
 	return com_rslt;
 }
+#ifdef BME280_ENABLE_FLOAT
+/*!
+ *	@brief This function converts the calibration parameters
+ *	for the double compensation. Only powers of two are folded
+ *	into the coefficients, which is exact, so the compensated
+ *	values are the same as with the datasheet formulas.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
+ */
+static void bme280_compute_double_coeff(struct bme280_t *p_bme280)
+{
+	struct bme280_calibration_param_t *p_cal = &p_bme280->cal_param;
+	struct bme280_double_coeff_t *p_coeff = &p_bme280->double_coeff;
+
+	p_coeff->t1 = ((double)p_cal->dig_T1) / 8192.0;
+	p_coeff->t2 = ((double)p_cal->dig_T2) * 8.0;
+	p_coeff->t3 = (double)p_cal->dig_T3;
+
+	p_coeff->p1 = (double)p_cal->dig_P1;
+	p_coeff->p2 = ((double)p_cal->dig_P2) / 17179869184.0;
+	p_coeff->p3 = ((double)p_cal->dig_P3) / 9007199254740992.0;
+	p_coeff->p4 = ((double)p_cal->dig_P4) * 16.0;
+	p_coeff->p5 = ((double)p_cal->dig_P5) / 8192.0;
+	p_coeff->p6 = ((double)p_cal->dig_P6) / 536870912.0;
+	p_coeff->p7 = ((double)p_cal->dig_P7) / 16.0;
+	p_coeff->p8 = ((double)p_cal->dig_P8) / 524288.0;
+	p_coeff->p9 = ((double)p_cal->dig_P9) / 34359738368.0;
+
+	p_coeff->h1 = ((double)p_cal->dig_H1) / 524288.0;
+	p_coeff->h2 = ((double)p_cal->dig_H2) / 65536.0;
+	p_coeff->h3 = ((double)p_cal->dig_H3) / 67108864.0;
+	p_coeff->h4 = ((double)p_cal->dig_H4) * 64.0;
+	p_coeff->h5 = ((double)p_cal->dig_H5) / 16384.0;
+	p_coeff->h6 = ((double)p_cal->dig_H6) / 67108864.0;
+}
+/*!
+ *	@brief This function converts the calibration parameters
+ *	for the single precision compensation
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
+ */
+static void bme280_compute_float_coeff(struct bme280_t *p_bme280)
+{
+	struct bme280_calibration_param_t *p_cal = &p_bme280->cal_param;
+	struct bme280_double_coeff_t *p_double = &p_bme280->double_coeff;
+	struct bme280_float_coeff_t *p_coeff = &p_bme280->float_coeff;
+
+	/* dig_T1 is subtracted in integer, the uncompensated
+	temperature and dig_T1 * 16 are close to each other and
+	would cancel out most of a float mantissa*/
+	p_coeff->t1 = ((s32)p_cal->dig_T1) <<
+	BME280_SHIFT_BIT_POSITION_BY_04_BITS;
+	p_coeff->t2 = ((float)p_cal->dig_T2) / 16384.0f;
+	p_coeff->t3 = ((float)p_cal->dig_T3) / 17179869184.0f;
+
+	/* the double coefficients only differ by powers of two*/
+	p_coeff->p1 = (float)p_double->p1;
+	p_coeff->p2 = (float)p_double->p2;
+	p_coeff->p3 = (float)p_double->p3;
+	p_coeff->p4 = (float)p_double->p4;
+	p_coeff->p5 = (float)p_double->p5;
+	p_coeff->p6 = (float)p_double->p6;
+	p_coeff->p7 = (float)p_double->p7;
+	p_coeff->p8 = (float)p_double->p8;
+	p_coeff->p9 = (float)p_double->p9;
+
+	p_coeff->h1 = (float)p_double->h1;
+	p_coeff->h2 = (float)p_double->h2;
+	p_coeff->h3 = (float)p_double->h3;
+	p_coeff->h4 = (float)p_double->h4;
+	p_coeff->h5 = (float)p_double->h5;
+	p_coeff->h6 = (float)p_double->h6;
+}
+#endif
 /*!
  *	@brief This API is used to
  *	calibration parameters used for calculation in the registers
@@ -634,13 +934,15 @@ u32 *v_pressure_u32, s32 *v_temperature_s32, u32 *v_humidity_u32)
  *	dig_H5    |  0xE5 and 0xE6   | from 0 : 3 to 4: 11
  *	dig_H6    |         0xE7     | from 0 to 7
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
  *	@return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void)
+BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(struct bme280_t *p_bme280)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -752,12 +1054,90 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void)
 			BME280_SHIFT_BIT_POSITION_BY_04_BITS));
 			p_bme280->cal_param.dig_H6 =
 			(s8)a_data_u8[BME280_HUMIDITY_CALIB_DIG_H6];
+#ifdef BME280_ENABLE_FLOAT
+			bme280_compute_double_coeff(p_bme280);
+			bme280_compute_float_coeff(p_bme280);
+#endif
 		}
 	return com_rslt;
 }
 /*!
- *	@brief This API is used to get
- *	the temperature oversampling setting in the register 0xF4
+ *	@brief This function initializes the device like bme280_init()
+ *	but takes the calibration parameters from a cache.
+ *	Only dig_T1 to dig_T3 are read back and compared with the
+ *	cache. When they match, the cached parameters are used and
+ *	the full calibration read is skipped. Otherwise the
+ *	calibration is read from the sensor.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *	@param p_calib_param : cached calibration parameters or
+ *	BME280_NULL when the cache is empty
+ *	@param v_cache_hit_u8 : BME280_CALIB_CACHE_HIT when the cached
+ *	parameters were used, BME280_CALIB_CACHE_MISS when the
+ *	calibration was read from the sensor
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_init_cached(struct bme280_t *p_bme280,
+const struct bme280_calibration_param_t *p_calib_param, u8 *v_cache_hit_u8)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 a_data_u8[BME280_CALIB_PROBE_SIZE] = {
+	BME280_INIT_VALUE, BME280_INIT_VALUE, BME280_INIT_VALUE,
+	BME280_INIT_VALUE, BME280_INIT_VALUE, BME280_INIT_VALUE};
+
+	/* check the p_bme280 structure pointer as NULL*/
+	if (p_bme280 == BME280_NULL || v_cache_hit_u8 == BME280_NULL)
+		return E_BME280_NULL_PTR;
+
+	*v_cache_hit_u8 = BME280_CALIB_CACHE_MISS;
+	com_rslt = bme280_read_chip_id(p_bme280);
+	if (com_rslt != BME280_CHIP_ID_READ_SUCCESS)
+		return com_rslt;
+
+	if (p_calib_param != BME280_NULL) {
+		/* the temperature words differ from part to part,
+		a swapped sensor fails the probe*/
+		com_rslt = p_bme280->BME280_BUS_READ_FUNC(
+		p_bme280->dev_addr,
+		BME280_TEMPERATURE_CALIB_DIG_T1_LSB_REG,
+		a_data_u8, BME280_CALIB_PROBE_DATA_LENGTH);
+		if (com_rslt == SUCCESS &&
+		p_calib_param->dig_T1 == (u16)((((u16)a_data_u8[
+		BME280_TEMPERATURE_CALIB_DIG_T1_MSB]) <<
+		BME280_SHIFT_BIT_POSITION_BY_08_BITS) |
+		a_data_u8[BME280_TEMPERATURE_CALIB_DIG_T1_LSB]) &&
+		p_calib_param->dig_T2 == (s16)((((s16)((s8)a_data_u8[
+		BME280_TEMPERATURE_CALIB_DIG_T2_MSB])) <<
+		BME280_SHIFT_BIT_POSITION_BY_08_BITS) |
+		a_data_u8[BME280_TEMPERATURE_CALIB_DIG_T2_LSB]) &&
+		p_calib_param->dig_T3 == (s16)((((s16)((s8)a_data_u8[
+		BME280_TEMPERATURE_CALIB_DIG_T3_MSB])) <<
+		BME280_SHIFT_BIT_POSITION_BY_08_BITS) |
+		a_data_u8[BME280_TEMPERATURE_CALIB_DIG_T3_LSB])) {
+			p_bme280->cal_param = *p_calib_param;
+			p_bme280->cal_param.t_fine = BME280_INIT_VALUE;
+#ifdef BME280_ENABLE_FLOAT
+			bme280_compute_double_coeff(p_bme280);
+			bme280_compute_float_coeff(p_bme280);
+#endif
+			*v_cache_hit_u8 = BME280_CALIB_CACHE_HIT;
+		}
+	}
+	if (*v_cache_hit_u8 == BME280_CALIB_CACHE_MISS)
+		com_rslt = bme280_get_calib_param(p_bme280);
+	/* prime the cached control registers */
+	com_rslt += bme280_read_ctrl_registers(p_bme280);
+	return com_rslt;
+}
+/*!
+ *	@brief This API is used to get
+ *	the temperature oversampling setting in the register 0xF4
  *	bits from 5 to 7
  *
  *	value               |   Temperature oversampling
@@ -770,6 +1150,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void)
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of temperature over sampling
  *
  *
@@ -781,7 +1162,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_temperature(
-u8 *v_value_u8)
+struct bme280_t *p_bme280, u8 *v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -816,6 +1197,7 @@ u8 *v_value_u8)
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of temperature over sampling
  *
  *
@@ -827,7 +1209,7 @@ u8 *v_value_u8)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_set_oversamp_temperature(
-u8 v_value_u8)
+struct bme280_t *p_bme280, u8 v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -843,14 +1225,15 @@ u8 v_value_u8)
 			v_data_u8 =
 			BME280_SET_BITSLICE(v_data_u8,
 			BME280_CTRL_MEAS_REG_OVERSAMP_TEMPERATURE, v_value_u8);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
 			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
+				com_rslt += bme280_set_soft_rst(p_bme280);
 				p_bme280->delay_msec(BME280_3MS_DELAY);
 				/* write previous value
 				of configuration register*/
 				v_pre_config_value_u8 = p_bme280->config_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CONFIG_REG,
 				&v_pre_config_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -858,13 +1241,13 @@ u8 v_value_u8)
 				of humidity oversampling*/
 				v_pre_ctrl_hum_value_u8 =
 				p_bme280->ctrl_hum_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 				&v_pre_ctrl_hum_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write previous and updated value
 				of configuration register*/
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			} else {
@@ -874,22 +1257,10 @@ u8 v_value_u8)
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			}
 				p_bme280->oversamp_temperature = v_value_u8;
-				/* read the control measurement register value*/
-				com_rslt = bme280_read_register(
-					BME280_CTRL_MEAS_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->ctrl_meas_reg = v_data_u8;
-				/* read the control humidity register value*/
-				com_rslt += bme280_read_register(
-					BME280_CTRL_HUMIDITY_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->ctrl_hum_reg = v_data_u8;
-				/* read the control
-				configuration register value*/
-				com_rslt += bme280_read_register(
-					BME280_CONFIG_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->config_reg = v_data_u8;
+				/* update the cached control registers*/
+				com_rslt += bme280_update_ctrl_registers(p_bme280,
+				p_bme280->ctrl_hum_reg, v_data_u8,
+				p_bme280->config_reg);
 		}
 	return com_rslt;
 }
@@ -908,6 +1279,7 @@ u8 v_value_u8)
  *	0x05,0x06 and 0x07 | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of pressure oversampling
  *
  *
@@ -919,7 +1291,7 @@ u8 v_value_u8)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_pressure(
-u8 *v_value_u8)
+struct bme280_t *p_bme280, u8 *v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -955,6 +1327,7 @@ u8 *v_value_u8)
  *	0x05,0x06 and 0x07 | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of pressure oversampling
  *
  *
@@ -966,7 +1339,7 @@ u8 *v_value_u8)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_set_oversamp_pressure(
-u8 v_value_u8)
+struct bme280_t *p_bme280, u8 v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -982,14 +1355,15 @@ u8 v_value_u8)
 			v_data_u8 =
 			BME280_SET_BITSLICE(v_data_u8,
 			BME280_CTRL_MEAS_REG_OVERSAMP_PRESSURE, v_value_u8);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
 			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
+				com_rslt += bme280_set_soft_rst(p_bme280);
 				p_bme280->delay_msec(BME280_3MS_DELAY);
 				/* write previous value of
 				configuration register*/
 				v_pre_config_value_u8 = p_bme280->config_reg;
-				com_rslt = bme280_write_register(
+				com_rslt = bme280_write_register(p_bme280,
 					BME280_CONFIG_REG,
 				&v_pre_config_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -997,13 +1371,13 @@ u8 v_value_u8)
 				humidity oversampling*/
 				v_pre_ctrl_hum_value_u8 =
 				p_bme280->ctrl_hum_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 				&v_pre_ctrl_hum_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write previous and updated value of
 				control measurement register*/
-				bme280_write_register(
+				bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			} else {
@@ -1013,22 +1387,10 @@ u8 v_value_u8)
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			}
 				p_bme280->oversamp_pressure = v_value_u8;
-				/* read the control measurement register value*/
-				com_rslt = bme280_read_register(
-					BME280_CTRL_MEAS_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->ctrl_meas_reg = v_data_u8;
-				/* read the control humidity register value*/
-				com_rslt += bme280_read_register(
-					BME280_CTRL_HUMIDITY_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->ctrl_hum_reg = v_data_u8;
-				/* read the control
-				configuration register value*/
-				com_rslt += bme280_read_register(
-					BME280_CONFIG_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->config_reg = v_data_u8;
+				/* update the cached control registers*/
+				com_rslt += bme280_update_ctrl_registers(p_bme280,
+				p_bme280->ctrl_hum_reg, v_data_u8,
+				p_bme280->config_reg);
 		}
 	return com_rslt;
 }
@@ -1047,6 +1409,7 @@ u8 v_value_u8)
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_value_u8 : The value of humidity over sampling
  *
  *
@@ -1058,7 +1421,7 @@ u8 v_value_u8)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_humidity(
-u8 *v_value_u8)
+struct bme280_t *p_bme280, u8 *v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1094,6 +1457,7 @@ u8 *v_value_u8)
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_value_u8 : The value of humidity over sampling
  *
  *
@@ -1119,7 +1483,7 @@ u8 *v_value_u8)
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_set_oversamp_humidity(
-u8 v_value_u8)
+struct bme280_t *p_bme280, u8 v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1136,26 +1500,27 @@ u8 v_value_u8)
 			v_data_u8 =
 			BME280_SET_BITSLICE(v_data_u8,
 			BME280_CTRL_HUMIDITY_REG_OVERSAMP_HUMIDITY, v_value_u8);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
 			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
+				com_rslt += bme280_set_soft_rst(p_bme280);
 				p_bme280->delay_msec(BME280_3MS_DELAY);
 				/* write previous value of
 				configuration register*/
 				v_pre_config_value_u8 = p_bme280->config_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CONFIG_REG,
 				&v_pre_config_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write the value of control humidity*/
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write previous value of
 				control measurement register*/
 				pre_ctrl_meas_value =
 				p_bme280->ctrl_meas_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&pre_ctrl_meas_value,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1169,25 +1534,16 @@ u8 v_value_u8)
 				after the control measurement register*/
 				pre_ctrl_meas_value =
 				p_bme280->ctrl_meas_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&pre_ctrl_meas_value,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
 			}
 			p_bme280->oversamp_humidity = v_value_u8;
-			/* read the control measurement register value*/
-			com_rslt += bme280_read_register(BME280_CTRL_MEAS_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_meas_reg = v_data_u8;
-			/* read the control humidity register value*/
-			com_rslt += bme280_read_register(
-			BME280_CTRL_HUMIDITY_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_hum_reg = v_data_u8;
-			/* read the control configuration register value*/
-			com_rslt += bme280_read_register(BME280_CONFIG_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->config_reg = v_data_u8;
+			/* update the cached control registers*/
+			com_rslt += bme280_update_ctrl_registers(p_bme280,
+			v_data_u8, p_bme280->ctrl_meas_reg,
+			p_bme280->config_reg);
 		}
 	return com_rslt;
 }
@@ -1197,6 +1553,7 @@ u8 v_value_u8)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_power_mode_u8 : The value of power mode
  *  value           |    mode
  * -----------------|------------------
@@ -1210,7 +1567,8 @@ u8 v_value_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(u8 *v_power_mode_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(
+struct bme280_t *p_bme280, u8 *v_power_mode_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1234,6 +1592,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(u8 *v_power_mode_u8)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_power_mode_u8 : The value of power mode
  *  value           |    mode
  * -----------------|------------------
@@ -1247,7 +1606,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(u8 *v_power_mode_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(
+struct bme280_t *p_bme280, u8 v_power_mode_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1255,7 +1615,6 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
 	u8 v_prev_pow_mode_u8 = BME280_INIT_VALUE;
 	u8 v_pre_ctrl_hum_value_u8 = BME280_INIT_VALUE;
 	u8 v_pre_config_value_u8 = BME280_INIT_VALUE;
-	u8 v_data_u8 = BME280_INIT_VALUE;
 	/* check the p_bme280 structure pointer as NULL*/
 	if (p_bme280 == BME280_NULL) {
 		return E_BME280_NULL_PTR;
@@ -1266,16 +1625,16 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
 				BME280_SET_BITSLICE(v_mode_u8r,
 				BME280_CTRL_MEAS_REG_POWER_MODE,
 				v_power_mode_u8);
-				com_rslt = bme280_get_power_mode(
+				com_rslt = bme280_get_prev_power_mode(p_bme280,
 					&v_prev_pow_mode_u8);
 				if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-					com_rslt += bme280_set_soft_rst();
+					com_rslt += bme280_set_soft_rst(p_bme280);
 					p_bme280->delay_msec(BME280_3MS_DELAY);
 					/* write previous value of
 					configuration register*/
 					v_pre_config_value_u8 =
 					p_bme280->config_reg;
-					com_rslt = bme280_write_register(
+					com_rslt = bme280_write_register(p_bme280,
 						BME280_CONFIG_REG,
 					&v_pre_config_value_u8,
 					BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1283,13 +1642,13 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
 					humidity oversampling*/
 					v_pre_ctrl_hum_value_u8 =
 					p_bme280->ctrl_hum_reg;
-					com_rslt += bme280_write_register(
+					com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 					&v_pre_ctrl_hum_value_u8,
 					BME280_GEN_READ_WRITE_DATA_LENGTH);
 					/* write previous and updated value of
 					control measurement register*/
-					com_rslt += bme280_write_register(
+					com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 					&v_mode_u8r,
 					BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1301,21 +1660,10 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
 					&v_mode_u8r,
 					BME280_GEN_READ_WRITE_DATA_LENGTH);
 				}
-				/* read the control measurement register value*/
-				com_rslt = bme280_read_register(
-					BME280_CTRL_MEAS_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->ctrl_meas_reg = v_data_u8;
-				/* read the control humidity register value*/
-				com_rslt += bme280_read_register(
-					BME280_CTRL_HUMIDITY_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->ctrl_hum_reg = v_data_u8;
-				/* read the config register value*/
-				com_rslt += bme280_read_register(
-					BME280_CONFIG_REG,
-				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-				p_bme280->config_reg = v_data_u8;
+				/* update the cached control registers*/
+				com_rslt += bme280_update_ctrl_registers(p_bme280,
+				p_bme280->ctrl_hum_reg, v_mode_u8r,
+				p_bme280->config_reg);
 			} else {
 			com_rslt = E_BME280_OUT_OF_RANGE;
 			}
@@ -1327,9 +1675,11 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
  * The value 0xB6 is written to the 0xE0
  * register the device is reset using the
  * complete power-on-reset procedure.
- * @note Soft reset can be easily set using bme280_set_softreset().
- * @note Usage Hint : bme280_set_softreset()
+ * @note Soft reset can be easily set using bme280_set_soft_rst(p_bme280).
+ * @note Usage Hint : bme280_set_soft_rst(p_bme280)
+ *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *
  *	@return results of bus communication function
  *	@retval 0 -> Success
@@ -1337,7 +1687,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(void)
+BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(struct bme280_t *p_bme280)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1359,6 +1709,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(void)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_enable_disable_u8 : The value of SPI enable
  *	value  | Description
  * --------|--------------
@@ -1373,7 +1724,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(void)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(u8 *v_enable_disable_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(
+struct bme280_t *p_bme280, u8 *v_enable_disable_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1398,6 +1750,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(u8 *v_enable_disable_u8)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_enable_disable_u8 : The value of SPI enable
  *	value  | Description
  * --------|--------------
@@ -1412,7 +1765,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(u8 *v_enable_disable_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(
+struct bme280_t *p_bme280, u8 v_enable_disable_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1428,20 +1782,21 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8)
 			v_data_u8 =
 			BME280_SET_BITSLICE(v_data_u8,
 			BME280_CONFIG_REG_SPI3_ENABLE, v_enable_disable_u8);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
 			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
+				com_rslt += bme280_set_soft_rst(p_bme280);
 				p_bme280->delay_msec(BME280_3MS_DELAY);
 				/* write previous and updated value of
 				configuration register*/
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CONFIG_REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write previous value of
 				humidity oversampling*/
 				v_pre_ctrl_hum_value_u8 =
 				p_bme280->ctrl_hum_reg;
-				com_rslt +=  bme280_write_register(
+				com_rslt +=  bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 				&v_pre_ctrl_hum_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1449,7 +1804,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8)
 				control measurement register*/
 				pre_ctrl_meas_value =
 				p_bme280->ctrl_meas_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&pre_ctrl_meas_value,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1460,21 +1815,10 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8)
 				BME280_CONFIG_REG_SPI3_ENABLE__REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			}
-			/* read the control measurement register value*/
-			com_rslt += bme280_read_register(
-				BME280_CTRL_MEAS_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_meas_reg = v_data_u8;
-			/* read the control humidity register value*/
-			com_rslt += bme280_read_register(
-				BME280_CTRL_HUMIDITY_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_hum_reg = v_data_u8;
-			/* read the control configuration register value*/
-			com_rslt += bme280_read_register(
-				BME280_CONFIG_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->config_reg = v_data_u8;
+			/* update the cached control registers*/
+			com_rslt += bme280_update_ctrl_registers(p_bme280,
+			p_bme280->ctrl_hum_reg, p_bme280->ctrl_meas_reg,
+			v_data_u8);
 		}
 	return com_rslt;
 }
@@ -1484,6 +1828,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_value_u8 : The value of IIR filter coefficient
  *
  *	value	    |	Filter coefficient
@@ -1500,7 +1845,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_filter(u8 *v_value_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_get_filter(
+struct bme280_t *p_bme280, u8 *v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1524,6 +1870,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_filter(u8 *v_value_u8)
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_value_u8 : The value of IIR filter coefficient
  *
  *	value	    |	Filter coefficient
@@ -1540,7 +1887,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_filter(u8 *v_value_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_set_filter(
+struct bme280_t *p_bme280, u8 v_value_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1556,20 +1904,21 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8)
 			v_data_u8 =
 			BME280_SET_BITSLICE(v_data_u8,
 			BME280_CONFIG_REG_FILTER, v_value_u8);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
 			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
+				com_rslt += bme280_set_soft_rst(p_bme280);
 				p_bme280->delay_msec(BME280_3MS_DELAY);
 				/* write previous and updated value of
 				configuration register*/
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CONFIG_REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write previous value of
 				humidity oversampling*/
 				v_pre_ctrl_hum_value_u8 =
 				p_bme280->ctrl_hum_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 				&v_pre_ctrl_hum_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1577,7 +1926,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8)
 				control measurement register*/
 				pre_ctrl_meas_value =
 				p_bme280->ctrl_meas_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&pre_ctrl_meas_value,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1588,19 +1937,10 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8)
 				BME280_CONFIG_REG_FILTER__REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			}
-			/* read the control measurement register value*/
-			com_rslt += bme280_read_register(BME280_CTRL_MEAS_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_meas_reg = v_data_u8;
-			/* read the control humidity register value*/
-			com_rslt += bme280_read_register(
-			BME280_CTRL_HUMIDITY_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_hum_reg = v_data_u8;
-			/* read the configuration register value*/
-			com_rslt += bme280_read_register(BME280_CONFIG_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->config_reg = v_data_u8;
+			/* update the cached control registers*/
+			com_rslt += bme280_update_ctrl_registers(p_bme280,
+			p_bme280->ctrl_hum_reg, p_bme280->ctrl_meas_reg,
+			v_data_u8);
 		}
 	return com_rslt;
 }
@@ -1608,6 +1948,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8)
  *	@brief This API used to Read the
  *	standby duration time from the sensor in the register 0xF5 bit 5 to 7
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_standby_durn_u8 : The value of standby duration time value.
  *  value       | standby duration
  * -------------|-----------------------
@@ -1627,7 +1968,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(u8 *v_standby_durn_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(
+struct bme280_t *p_bme280, u8 *v_standby_durn_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1649,6 +1991,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(u8 *v_standby_durn_u8)
  *	@brief This API used to write the
  *	standby duration time from the sensor in the register 0xF5 bit 5 to 7
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_standby_durn_u8 : The value of standby duration time value.
  *  value       | standby duration
  * -------------|-----------------------
@@ -1668,7 +2011,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(u8 *v_standby_durn_u8)
  *	the contents of the register t_sb.
  *	Standby time can be set using BME280_STANDBY_TIME_125_MS.
  *
- *	@note Usage Hint : bme280_set_standby_durn(BME280_STANDBY_TIME_125_MS)
+ *	@note Usage Hint : bme280_set_standby_durn(p_bme280,
+ *	BME280_STANDBY_TIME_125_MS)
  *
  *
  *
@@ -1678,7 +2022,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(u8 *v_standby_durn_u8)
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8)
+BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(
+struct bme280_t *p_bme280, u8 v_standby_durn_u8)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
@@ -1694,20 +2039,21 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8)
 			v_data_u8 =
 			BME280_SET_BITSLICE(v_data_u8,
 			BME280_CONFIG_REG_TSB, v_standby_durn_u8);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
 			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
+				com_rslt += bme280_set_soft_rst(p_bme280);
 				p_bme280->delay_msec(BME280_3MS_DELAY);
 				/* write previous and updated value of
 				configuration register*/
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CONFIG_REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 				/* write previous value of
 				humidity oversampling*/
 				v_pre_ctrl_hum_value_u8 =
 				p_bme280->ctrl_hum_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_HUMIDITY_REG,
 				&v_pre_ctrl_hum_value_u8,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1715,7 +2061,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8)
 				measurement register*/
 				pre_ctrl_meas_value =
 				p_bme280->ctrl_meas_reg;
-				com_rslt += bme280_write_register(
+				com_rslt += bme280_write_register(p_bme280,
 					BME280_CTRL_MEAS_REG,
 				&pre_ctrl_meas_value,
 				BME280_GEN_READ_WRITE_DATA_LENGTH);
@@ -1726,19 +2072,120 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8)
 				BME280_CONFIG_REG_TSB__REG,
 				&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
 			}
-			/* read the control measurement register value*/
-			com_rslt += bme280_read_register(BME280_CTRL_MEAS_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_meas_reg = v_data_u8;
-			/* read the control humidity register value*/
-			com_rslt += bme280_read_register(
-			BME280_CTRL_HUMIDITY_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_hum_reg = v_data_u8;
-			/* read the configuration register value*/
-			com_rslt += bme280_read_register(BME280_CONFIG_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->config_reg = v_data_u8;
+			/* update the cached control registers*/
+			com_rslt += bme280_update_ctrl_registers(p_bme280,
+			p_bme280->ctrl_hum_reg, p_bme280->ctrl_meas_reg,
+			v_data_u8);
+		}
+	return com_rslt;
+}
+/*!
+ *	@brief This API writes the oversampling, standby, filter
+ *	and power mode settings in one burst write of register and
+ *	value pairs: 0xF4 (sleep), 0xF2, 0xF5 and 0xF4.
+ *	Entering sleep first makes the configuration register
+ *	writable and the last write latches the humidity setting,
+ *	so no soft reset is needed whatever the previous mode was.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *	@param p_config : settings to apply
+ *	@param v_verify_u8 : BME280_CONFIG_VERIFY_ENABLE to read the
+ *	registers back and compare them with the written values
+ *
+ *	@note Usage Hint : bme280_apply_config(p_bme280, &config,
+ *	BME280_CONFIG_VERIFY_DISABLE)
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -3 -> Read back registers differ
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_apply_config(
+struct bme280_t *p_bme280, const struct bme280_config_t *p_config,
+u8 v_verify_u8)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 a_data_u8[BME280_CONFIG_BURST_SIZE] = {
+	BME280_INIT_VALUE, BME280_INIT_VALUE,
+	BME280_INIT_VALUE, BME280_INIT_VALUE,
+	BME280_INIT_VALUE, BME280_INIT_VALUE,
+	BME280_INIT_VALUE, BME280_INIT_VALUE};
+	u8 v_ctrl_hum_u8 = BME280_INIT_VALUE;
+	u8 v_ctrl_meas_u8 = BME280_INIT_VALUE;
+	u8 v_config_u8 = BME280_INIT_VALUE;
+	u8 v_meas_mask_u8 = BME280_INIT_VALUE;
+	/* check the p_bme280 structure pointer as NULL*/
+	if (p_bme280 == BME280_NULL || p_config == BME280_NULL) {
+		return E_BME280_NULL_PTR;
+		} else {
+			if (p_config->power_mode > BME280_NORMAL_MODE)
+				return E_BME280_OUT_OF_RANGE;
+
+			v_ctrl_hum_u8 = BME280_SET_BITSLICE(
+			p_bme280->ctrl_hum_reg,
+			BME280_CTRL_HUMIDITY_REG_OVERSAMP_HUMIDITY,
+			p_config->oversamp_humidity);
+			v_ctrl_meas_u8 = BME280_SET_BITSLICE(
+			p_bme280->ctrl_meas_reg,
+			BME280_CTRL_MEAS_REG_OVERSAMP_TEMPERATURE,
+			p_config->oversamp_temperature);
+			v_ctrl_meas_u8 = BME280_SET_BITSLICE(v_ctrl_meas_u8,
+			BME280_CTRL_MEAS_REG_OVERSAMP_PRESSURE,
+			p_config->oversamp_pressure);
+			/* the spi3 bit of the configuration is kept*/
+			v_config_u8 = BME280_SET_BITSLICE(p_bme280->config_reg,
+			BME280_CONFIG_REG_TSB, p_config->standby_durn);
+			v_config_u8 = BME280_SET_BITSLICE(v_config_u8,
+			BME280_CONFIG_REG_FILTER, p_config->filter);
+
+			/* the first register address is passed to the bus
+			function, the others travel as register/value pairs*/
+			a_data_u8[0] = BME280_SET_BITSLICE(v_ctrl_meas_u8,
+			BME280_CTRL_MEAS_REG_POWER_MODE, BME280_SLEEP_MODE);
+			a_data_u8[1] = BME280_CTRL_HUMIDITY_REG;
+			a_data_u8[2] = v_ctrl_hum_u8;
+			a_data_u8[3] = BME280_CONFIG_REG;
+			a_data_u8[4] = v_config_u8;
+			a_data_u8[5] = BME280_CTRL_MEAS_REG;
+			v_ctrl_meas_u8 = BME280_SET_BITSLICE(v_ctrl_meas_u8,
+			BME280_CTRL_MEAS_REG_POWER_MODE, p_config->power_mode);
+			a_data_u8[6] = v_ctrl_meas_u8;
+			com_rslt = p_bme280->BME280_BUS_WRITE_FUNC(
+			p_bme280->dev_addr, BME280_CTRL_MEAS_REG,
+			a_data_u8, BME280_CONFIG_BURST_WRITE_DATA_LENGTH);
+			if (com_rslt != SUCCESS)
+				return com_rslt;
+
+			p_bme280->oversamp_temperature =
+			p_config->oversamp_temperature;
+			p_bme280->oversamp_pressure = p_config->oversamp_pressure;
+			p_bme280->oversamp_humidity = p_config->oversamp_humidity;
+
+			if (v_verify_u8 != BME280_CONFIG_VERIFY_ENABLE) {
+				/* update the cached control registers*/
+				return bme280_update_ctrl_registers(p_bme280,
+				v_ctrl_hum_u8, v_ctrl_meas_u8, v_config_u8);
+			}
+
+			com_rslt = bme280_read_ctrl_registers(p_bme280);
+			if (com_rslt != SUCCESS)
+				return com_rslt;
+			/* a forced conversion may already be over*/
+			v_meas_mask_u8 = (p_config->power_mode ==
+			BME280_NORMAL_MODE) ? 0xFF :
+			(u8)~BME280_CTRL_MEAS_REG_POWER_MODE__MSK;
+			if (((p_bme280->ctrl_hum_reg ^ v_ctrl_hum_u8) &
+			BME280_CTRL_HUMIDITY_REG_OVERSAMP_HUMIDITY__MSK) ||
+			((p_bme280->ctrl_meas_reg ^ v_ctrl_meas_u8) &
+			v_meas_mask_u8) ||
+			((p_bme280->config_reg ^ v_config_u8) &
+			(BME280_CONFIG_REG_TSB__MSK |
+			BME280_CONFIG_REG_FILTER__MSK |
+			BME280_CONFIG_REG_SPI3_ENABLE__MSK)))
+				com_rslt = E_BME280_VERIFY_FAIL;
 		}
 	return com_rslt;
 }
@@ -1821,11 +2268,78 @@ if (p_bme280 == BME280_NULL) {
 }
 return com_rslt;
 }*/
+/*!
+ * @brief This API starts one forced mode conversion with a
+ * single write of the register 0xF4. A sensor in normal mode
+ * is put to sleep in the same burst, the other control
+ * registers are left as they are.
+ * The cached power mode is set to sleep, where the sensor
+ * returns by itself once the conversion is done.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
+ *	@note Usage Hint : bme280_trigger_forced_measurement(p_bme280)
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_trigger_forced_measurement(
+struct bme280_t *p_bme280)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 v_prev_pow_mode_u8 = BME280_INIT_VALUE;
+	u8 v_sleep_u8 = BME280_INIT_VALUE;
+	u8 a_data_u8[BME280_FORCED_TRIGGER_SIZE] = {
+	BME280_INIT_VALUE, BME280_INIT_VALUE, BME280_INIT_VALUE};
+	/* check the p_bme280 structure pointer as NULL*/
+	if (p_bme280 == BME280_NULL) {
+		return E_BME280_NULL_PTR;
+		} else {
+			v_sleep_u8 = BME280_SET_BITSLICE(p_bme280->ctrl_meas_reg,
+			BME280_CTRL_MEAS_REG_POWER_MODE, BME280_SLEEP_MODE);
+			com_rslt = bme280_get_prev_power_mode(p_bme280,
+			&v_prev_pow_mode_u8);
+			if (com_rslt != SUCCESS)
+				return com_rslt;
+			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
+				/* normal mode has to pass through sleep:
+				two register/value pairs in one burst*/
+				a_data_u8[0] = v_sleep_u8;
+				a_data_u8[1] = BME280_CTRL_MEAS_REG;
+				a_data_u8[2] = BME280_SET_BITSLICE(v_sleep_u8,
+				BME280_CTRL_MEAS_REG_POWER_MODE,
+				BME280_FORCED_MODE);
+				com_rslt = p_bme280->BME280_BUS_WRITE_FUNC(
+				p_bme280->dev_addr, BME280_CTRL_MEAS_REG,
+				a_data_u8, BME280_FORCED_TRIGGER_SIZE);
+			} else {
+				a_data_u8[0] = BME280_SET_BITSLICE(v_sleep_u8,
+				BME280_CTRL_MEAS_REG_POWER_MODE,
+				BME280_FORCED_MODE);
+				com_rslt = p_bme280->BME280_BUS_WRITE_FUNC(
+				p_bme280->dev_addr, BME280_CTRL_MEAS_REG,
+				a_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
+			}
+			if (com_rslt == SUCCESS)
+				p_bme280->ctrl_meas_reg = v_sleep_u8;
+		}
+	return com_rslt;
+}
 /*!
  * @brief This API used to read uncompensated
  * temperature,pressure and humidity in forced mode
  *
+ * The conversion is triggered with
+ * bme280_trigger_forced_measurement(), the typical
+ * conversion time is waited, bme280_wait_ready()
+ * polls until the data is valid and the data frame
+ * is burst read.
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_uncom_pressure_s32: The value of uncompensated pressure
  *	@param v_uncom_temperature_s32: The value of uncompensated temperature
  *	@param v_uncom_humidity_s32: The value of uncompensated humidity
@@ -1834,90 +2348,44 @@ return com_rslt;
  *	@return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
+ *	@retval -4 -> Conversion not finished in time
  *
  *
 */
 BME280_RETURN_FUNCTION_TYPE
 bme280_get_forced_uncomp_pressure_temperature_humidity(
-s32 *v_uncom_pressure_s32,
+struct bme280_t *p_bme280, s32 *v_uncom_pressure_s32,
 s32 *v_uncom_temperature_s32, s32 *v_uncom_humidity_s32)
 {
 	/* used to return the communication result*/
 	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
-	u8 v_data_u8 = BME280_INIT_VALUE;
-	u8 v_waittime_u8 = BME280_INIT_VALUE;
-	u8 v_prev_pow_mode_u8 = BME280_INIT_VALUE;
-	u8 v_mode_u8r = BME280_INIT_VALUE;
-	u8 pre_ctrl_config_value = BME280_INIT_VALUE;
-	u8 v_pre_ctrl_hum_value_u8 = BME280_INIT_VALUE;
+	u32 v_waittime_u32 = BME280_INIT_VALUE;
+	u32 v_timeout_u32 = BME280_INIT_VALUE;
 	/* check the p_bme280 structure pointer as NULL*/
 	if (p_bme280 == BME280_NULL) {
 		return E_BME280_NULL_PTR;
 		} else {
-			v_mode_u8r = p_bme280->ctrl_meas_reg;
-			v_mode_u8r =
-			BME280_SET_BITSLICE(v_mode_u8r,
-			BME280_CTRL_MEAS_REG_POWER_MODE, BME280_FORCED_MODE);
-			com_rslt = bme280_get_power_mode(&v_prev_pow_mode_u8);
-			if (v_prev_pow_mode_u8 != BME280_SLEEP_MODE) {
-				com_rslt += bme280_set_soft_rst();
-				p_bme280->delay_msec(BME280_3MS_DELAY);
-				/* write previous and updated value of
-				configuration register*/
-				pre_ctrl_config_value = p_bme280->config_reg;
-				com_rslt += bme280_write_register(
-					BME280_CONFIG_REG,
-				&pre_ctrl_config_value,
-				BME280_GEN_READ_WRITE_DATA_LENGTH);
-				/* write previous value of
-				humidity oversampling*/
-				v_pre_ctrl_hum_value_u8 =
-				p_bme280->ctrl_hum_reg;
-				com_rslt += bme280_write_register(
-					BME280_CTRL_HUMIDITY_REG,
-				&v_pre_ctrl_hum_value_u8,
-				BME280_GEN_READ_WRITE_DATA_LENGTH);
-				/* write the force mode  */
-				com_rslt += bme280_write_register(
-					BME280_CTRL_MEAS_REG,
-				&v_mode_u8r, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			} else {
-				/* write previous value of
-				humidity oversampling*/
-				v_pre_ctrl_hum_value_u8 =
-				p_bme280->ctrl_hum_reg;
-				com_rslt += bme280_write_register(
-					BME280_CTRL_HUMIDITY_REG,
-				&v_pre_ctrl_hum_value_u8,
-				BME280_GEN_READ_WRITE_DATA_LENGTH);
-				/* write the force mode  */
-				com_rslt += bme280_write_register(
-					BME280_CTRL_MEAS_REG,
-				&v_mode_u8r, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			}
-			bme280_compute_wait_time(&v_waittime_u8);
-			p_bme280->delay_msec(v_waittime_u8);
+			com_rslt = bme280_trigger_forced_measurement(p_bme280);
+			if (com_rslt != SUCCESS)
+				return com_rslt;
+			/* sleep through the typical conversion time and
+			poll the status until the worst case is over*/
+			bme280_compute_typical_measurement_time_usec(p_bme280,
+			&v_waittime_u32);
+			bme280_wait_usec(p_bme280, v_waittime_u32);
+			bme280_compute_measurement_time_usec(p_bme280,
+			&v_timeout_u32);
+			com_rslt = bme280_wait_ready(p_bme280,
+			v_timeout_u32 - v_waittime_u32 +
+			BME280_WAIT_READY_MARGIN_USEC);
+			if (com_rslt != SUCCESS)
+				return com_rslt;
 			/* read the force-mode value of pressure
 			temperature and humidity*/
-			com_rslt +=
-			bme280_read_uncomp_pressure_temperature_humidity(
+			com_rslt =
+			bme280_read_uncomp_pressure_temperature_humidity(p_bme280,
 			v_uncom_pressure_s32, v_uncom_temperature_s32,
 			v_uncom_humidity_s32);
-
-			/* read the control humidity register value*/
-			com_rslt += bme280_read_register(
-			BME280_CTRL_HUMIDITY_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_hum_reg = v_data_u8;
-			/* read the configuration register value*/
-			com_rslt += bme280_read_register(BME280_CONFIG_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->config_reg = v_data_u8;
-
-			/* read the control measurement register value*/
-			com_rslt += bme280_read_register(BME280_CTRL_MEAS_REG,
-			&v_data_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
-			p_bme280->ctrl_meas_reg = v_data_u8;
 		}
 	return com_rslt;
 }
@@ -1927,6 +2395,7 @@ s32 *v_uncom_temperature_s32, s32 *v_uncom_humidity_s32)
  *	the given register
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_addr_u8 -> Address of the register
  *	@param v_data_u8 -> The data from the register
  *	@param v_len_u8 -> no of bytes to read
@@ -1938,7 +2407,8 @@ s32 *v_uncom_temperature_s32, s32 *v_uncom_humidity_s32)
  *
  *
  */
-BME280_RETURN_FUNCTION_TYPE bme280_write_register(u8 v_addr_u8,
+BME280_RETURN_FUNCTION_TYPE bme280_write_register(
+struct bme280_t *p_bme280, u8 v_addr_u8,
 u8 *v_data_u8, u8 v_len_u8)
 {
 	/* used to return the communication result*/
@@ -1959,6 +2429,7 @@ u8 *v_data_u8, u8 v_len_u8)
  *	the given register
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_addr_u8 -> Address of the register
  *	@param v_data_u8 -> The data from the register
  *	@param v_len_u8 -> no of bytes to read
@@ -1970,7 +2441,8 @@ u8 *v_data_u8, u8 v_len_u8)
  *
  *
  */
-BME280_RETURN_FUNCTION_TYPE bme280_read_register(u8 v_addr_u8,
+BME280_RETURN_FUNCTION_TYPE bme280_read_register(
+struct bme280_t *p_bme280, u8 v_addr_u8,
 u8 *v_data_u8, u8 v_len_u8)
 {
 	/* used to return the communication result*/
@@ -1986,6 +2458,27 @@ u8 *v_data_u8, u8 v_len_u8)
 	return com_rslt;
 }
 #ifdef BME280_ENABLE_FLOAT
+static inline double bme280_temperature_double_kernel(
+const struct bme280_double_coeff_t *p_coeff,
+s32 v_uncom_temperature_s32, s32 *v_t_fine_s32)
+{
+	double v_x1_u32 = BME280_INIT_VALUE;
+	double v_x2_u32 = BME280_INIT_VALUE;
+	double v_dt_u32 = BME280_INIT_VALUE;
+	double temperature = BME280_INIT_VALUE;
+
+	/* uncomp / 2^17 - dig_T1 / 2^13, both terms of the
+	datasheet formula are multiples of it*/
+	v_dt_u32 = ((double)v_uncom_temperature_s32) / 131072.0 -
+	p_coeff->t1;
+	v_x1_u32 = v_dt_u32 * p_coeff->t2;
+	v_x2_u32 = (v_dt_u32 * v_dt_u32) * p_coeff->t3;
+	*v_t_fine_s32 = (s32)(v_x1_u32 + v_x2_u32);
+	temperature  = (v_x1_u32 + v_x2_u32) / 5120.0;
+
+
+	return temperature;
+}
 /*!
  * @brief Reads actual temperature from uncompensated temperature
  * @note returns the value in Degree centigrade
@@ -1993,6 +2486,7 @@ u8 *v_data_u8, u8 v_len_u8)
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_temperature_s32 : value of uncompensated temperature
  *
  *
@@ -2000,25 +2494,39 @@ u8 *v_data_u8, u8 v_len_u8)
  *  @return  Return the actual temperature in floating point
  *
 */
-double bme280_compensate_temperature_double(s32 v_uncom_temperature_s32)
+double bme280_compensate_temperature_double(
+struct bme280_t *p_bme280, s32 v_uncom_temperature_s32)
+{
+	return bme280_temperature_double_kernel(&p_bme280->double_coeff,
+	v_uncom_temperature_s32, &p_bme280->cal_param.t_fine);
+}
+static inline double bme280_pressure_double_kernel(
+const struct bme280_double_coeff_t *p_coeff,
+s32 v_t_fine_s32, s32 v_uncom_pressure_s32)
 {
 	double v_x1_u32 = BME280_INIT_VALUE;
 	double v_x2_u32 = BME280_INIT_VALUE;
-	double temperature = BME280_INIT_VALUE;
-
-	v_x1_u32  = (((double)v_uncom_temperature_s32) / 16384.0 -
-	((double)p_bme280->cal_param.dig_T1) / 1024.0) *
-	((double)p_bme280->cal_param.dig_T2);
-	v_x2_u32  = ((((double)v_uncom_temperature_s32) / 131072.0 -
-	((double)p_bme280->cal_param.dig_T1) / 8192.0) *
-	(((double)v_uncom_temperature_s32) / 131072.0 -
-	((double)p_bme280->cal_param.dig_T1) / 8192.0)) *
-	((double)p_bme280->cal_param.dig_T3);
-	p_bme280->cal_param.t_fine = (s32)(v_x1_u32 + v_x2_u32);
-	temperature  = (v_x1_u32 + v_x2_u32) / 5120.0;
+	double pressure = BME280_INIT_VALUE;
 
+	v_x1_u32 = ((double)v_t_fine_s32 /
+	2.0) - 64000.0;
+	v_x2_u32 = (v_x1_u32 * v_x1_u32) * p_coeff->p6 +
+	v_x1_u32 * p_coeff->p5;
+	v_x2_u32 = v_x2_u32 + p_coeff->p4;
+	v_x1_u32 = (p_coeff->p3 * v_x1_u32) * v_x1_u32 +
+	p_coeff->p2 * v_x1_u32;
+	v_x1_u32 = (1.0 + v_x1_u32) * p_coeff->p1;
+	pressure = 1048576.0 - (double)v_uncom_pressure_s32;
+	/* Avoid exception caused by division by zero */
+	if ((v_x1_u32 > 0) || (v_x1_u32 < 0))
+		pressure = (pressure - v_x2_u32) * 6250.0 / v_x1_u32;
+	else
+		return BME280_INVALID_DATA;
+	v_x1_u32 = (p_coeff->p9 * pressure) * pressure;
+	v_x2_u32 = pressure * p_coeff->p8;
+	pressure = pressure + (v_x1_u32 + v_x2_u32 + p_coeff->p7);
 
-	return temperature;
+	return pressure;
 }
 /*!
  * @brief Reads actual pressure from uncompensated pressure
@@ -2027,50 +2535,47 @@ double bme280_compensate_temperature_double(s32 v_uncom_temperature_s32)
  * equals 96386.2 Pa = 963.862 hPa.
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_pressure_s32 : value of uncompensated pressure
  *
  *
  *  @return  Return the actual pressure in floating point
  *
 */
-double bme280_compensate_pressure_double(s32 v_uncom_pressure_s32)
+double bme280_compensate_pressure_double(
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32)
 {
-	double v_x1_u32 = BME280_INIT_VALUE;
-	double v_x2_u32 = BME280_INIT_VALUE;
-	double pressure = BME280_INIT_VALUE;
+	return bme280_pressure_double_kernel(&p_bme280->double_coeff,
+	p_bme280->cal_param.t_fine, v_uncom_pressure_s32);
+}
+static inline double bme280_humidity_double_kernel(
+const struct bme280_double_coeff_t *p_coeff,
+s32 v_t_fine_s32, s32 v_uncom_humidity_s32)
+{
+	double var_h = BME280_INIT_VALUE;
 
-	v_x1_u32 = ((double)p_bme280->cal_param.t_fine /
-	2.0) - 64000.0;
-	v_x2_u32 = v_x1_u32 * v_x1_u32 *
-	((double)p_bme280->cal_param.dig_P6) / 32768.0;
-	v_x2_u32 = v_x2_u32 + v_x1_u32 *
-	((double)p_bme280->cal_param.dig_P5) * 2.0;
-	v_x2_u32 = (v_x2_u32 / 4.0) +
-	(((double)p_bme280->cal_param.dig_P4) * 65536.0);
-	v_x1_u32 = (((double)p_bme280->cal_param.dig_P3) *
-	v_x1_u32 * v_x1_u32 / 524288.0 +
-	((double)p_bme280->cal_param.dig_P2) * v_x1_u32) / 524288.0;
-	v_x1_u32 = (1.0 + v_x1_u32 / 32768.0) *
-	((double)p_bme280->cal_param.dig_P1);
-	pressure = 1048576.0 - (double)v_uncom_pressure_s32;
-	/* Avoid exception caused by division by zero */
-	if ((v_x1_u32 > 0) || (v_x1_u32 < 0))
-		pressure = (pressure - (v_x2_u32 / 4096.0)) * 6250.0 / v_x1_u32;
+	var_h = (((double)v_t_fine_s32) - 76800.0);
+	if ((var_h > 0) || (var_h < 0))
+		var_h = (v_uncom_humidity_s32 -
+		(p_coeff->h4 + p_coeff->h5 * var_h)) *
+		(p_coeff->h2 * (1.0 + p_coeff->h6 * var_h *
+		(1.0 + p_coeff->h3 * var_h)));
 	else
 		return BME280_INVALID_DATA;
-	v_x1_u32 = ((double)p_bme280->cal_param.dig_P9) *
-	pressure * pressure / 2147483648.0;
-	v_x2_u32 = pressure * ((double)p_bme280->cal_param.dig_P8) / 32768.0;
-	pressure = pressure + (v_x1_u32 + v_x2_u32 +
-	((double)p_bme280->cal_param.dig_P7)) / 16.0;
+	var_h = var_h * (1.0 - p_coeff->h1 * var_h);
+	if (var_h > 100.0)
+		var_h = 100.0;
+	else if (var_h < 0.0)
+		var_h = 0.0;
+	return var_h;
 
-	return pressure;
 }
 /*!
  * @brief Reads actual humidity from uncompensated humidity
  * @note returns the value in relative humidity (%rH)
  * @note Output value of "42.12" equals 42.12 %rH
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_humidity_s32 : value of uncompensated humidity
  *
  *
@@ -2078,72 +2583,154 @@ double bme280_compensate_pressure_double(s32 v_uncom_pressure_s32)
  *  @return Return the actual humidity in floating point
  *
 */
-double bme280_compensate_humidity_double(s32 v_uncom_humidity_s32)
+double bme280_compensate_humidity_double(
+struct bme280_t *p_bme280, s32 v_uncom_humidity_s32)
 {
-	double var_h = BME280_INIT_VALUE;
+	return bme280_humidity_double_kernel(&p_bme280->double_coeff,
+	p_bme280->cal_param.t_fine, v_uncom_humidity_s32);
+}
+static inline float bme280_temperature_float_kernel(
+const struct bme280_float_coeff_t *p_coeff,
+s32 v_uncom_temperature_s32, s32 *v_t_fine_s32)
+{
+	float v_dt_f = BME280_INIT_VALUE;
+	float v_x1_f = BME280_INIT_VALUE;
+	float v_x2_f = BME280_INIT_VALUE;
 
-	var_h = (((double)p_bme280->cal_param.t_fine) - 76800.0);
-	if ((var_h > 0) || (var_h < 0))
-		var_h = (v_uncom_humidity_s32 -
-		(((double)p_bme280->cal_param.dig_H4) * 64.0 +
-		((double)p_bme280->cal_param.dig_H5) / 16384.0 * var_h))*
-		(((double)p_bme280->cal_param.dig_H2) / 65536.0 *
-		(1.0 + ((double) p_bme280->cal_param.dig_H6)
-		/ 67108864.0 * var_h * (1.0 + ((double)
-		p_bme280->cal_param.dig_H3) / 67108864.0 * var_h)));
-	else
-		return BME280_INVALID_DATA;
-	var_h = var_h * (1.0 - ((double)
-	p_bme280->cal_param.dig_H1)*var_h / 524288.0);
-	if (var_h > 100.0)
-		var_h = 100.0;
-	else if (var_h < 0.0)
-		var_h = 0.0;
-	return var_h;
+	/* exact in float, the difference has at most 20 bits*/
+	v_dt_f = (float)(v_uncom_temperature_s32 - p_coeff->t1);
+	v_x1_f = v_dt_f * p_coeff->t2;
+	v_x2_f = (v_dt_f * v_dt_f) * p_coeff->t3;
+	*v_t_fine_s32 = (s32)(v_x1_f + v_x2_f);
+	return (v_x1_f + v_x2_f) / 5120.0f;
+}
+/*!
+ * @brief Reads actual temperature from uncompensated temperature
+ * in single precision, for FPUs without double support
+ * @note returns the value in Degree centigrade
+ * @note The difference to the double output is far below
+ * the resolution of the sensor.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *
+ *
+ *  @return  Return the actual temperature in floating point
+ *
+*/
+float bme280_compensate_temperature_float(
+struct bme280_t *p_bme280, s32 v_uncom_temperature_s32)
+{
+	return bme280_temperature_float_kernel(&p_bme280->float_coeff,
+	v_uncom_temperature_s32, &p_bme280->cal_param.t_fine);
+}
+static inline float bme280_pressure_float_kernel(
+const struct bme280_float_coeff_t *p_coeff,
+s32 v_t_fine_s32, s32 v_uncom_pressure_s32)
+{
+	float v_x1_f = BME280_INIT_VALUE;
+	float v_x2_f = BME280_INIT_VALUE;
+	float pressure = BME280_INIT_VALUE;
 
+	v_x1_f = ((float)v_t_fine_s32) * 0.5f - 64000.0f;
+	v_x2_f = (v_x1_f * v_x1_f) * p_coeff->p6 +
+	v_x1_f * p_coeff->p5 + p_coeff->p4;
+	v_x1_f = ((p_coeff->p3 * v_x1_f) * v_x1_f +
+	p_coeff->p2 * v_x1_f + 1.0f) * p_coeff->p1;
+	/* Avoid exception caused by division by zero */
+	if (v_x1_f == 0.0f)
+		return BME280_INVALID_DATA;
+	/* exact in float, both terms have at most 21 bits*/
+	pressure = (float)(1048576 - v_uncom_pressure_s32);
+	pressure = (pressure - v_x2_f) * (6250.0f / v_x1_f);
+	v_x1_f = (p_coeff->p9 * pressure) * pressure;
+	v_x2_f = pressure * p_coeff->p8;
+	return pressure + (v_x1_f + v_x2_f + p_coeff->p7);
 }
-#endif
-#if defined(BME280_ENABLE_INT64) && defined(BME280_64BITSUPPORT_PRESENT)
 /*!
  * @brief Reads actual pressure from uncompensated pressure
- * @note Returns the value in Pa as unsigned 32 bit
- * integer in Q24.8 format (24 integer bits and
- * 8 fractional bits).
- * @note Output value of "24674867"
- * represents 24674867 / 256 = 96386.2 Pa = 963.862 hPa
+ * in single precision, for FPUs without double support
+ * @note Returns pressure in Pa as float.
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
  *
  *
- *  @param  v_uncom_pressure_s32 : value of uncompensated temperature
+ *  @return  Return the actual pressure in floating point
  *
+*/
+float bme280_compensate_pressure_float(
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32)
+{
+	return bme280_pressure_float_kernel(&p_bme280->float_coeff,
+	p_bme280->cal_param.t_fine, v_uncom_pressure_s32);
+}
+static inline float bme280_humidity_float_kernel(
+const struct bme280_float_coeff_t *p_coeff,
+s32 v_t_fine_s32, s32 v_uncom_humidity_s32)
+{
+	float var_h = BME280_INIT_VALUE;
+
+	if (v_t_fine_s32 == 76800)
+		return BME280_INVALID_DATA;
+	var_h = (float)(v_t_fine_s32 - 76800);
+	var_h = ((float)v_uncom_humidity_s32 -
+	(p_coeff->h4 + p_coeff->h5 * var_h)) *
+	(p_coeff->h2 * (1.0f + p_coeff->h6 * var_h *
+	(1.0f + p_coeff->h3 * var_h)));
+	var_h = var_h * (1.0f - p_coeff->h1 * var_h);
+	if (var_h > 100.0f)
+		var_h = 100.0f;
+	else if (var_h < 0.0f)
+		var_h = 0.0f;
+	return var_h;
+}
+/*!
+ * @brief Reads actual humidity from uncompensated humidity
+ * in single precision, for FPUs without double support
+ * @note returns the value in relative humidity (%rH)
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
  *
- *  @return Return the actual pressure in u32
+ *
+ *  @return Return the actual humidity in floating point
  *
 */
-u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32)
+float bme280_compensate_humidity_float(
+struct bme280_t *p_bme280, s32 v_uncom_humidity_s32)
+{
+	return bme280_humidity_float_kernel(&p_bme280->float_coeff,
+	p_bme280->cal_param.t_fine, v_uncom_humidity_s32);
+}
+#endif
+#if defined(BME280_ENABLE_INT64) && defined(BME280_64BITSUPPORT_PRESENT)
+static inline u32 bme280_pressure_int64_kernel(
+const struct bme280_calibration_param_t *p_cal,
+s32 v_t_fine_s32, s32 v_uncom_pressure_s32)
 {
 	s64 v_x1_s64r = BME280_INIT_VALUE;
 	s64 v_x2_s64r = BME280_INIT_VALUE;
 	s64 pressure = BME280_INIT_VALUE;
 
-	v_x1_s64r = ((s64)p_bme280->cal_param.t_fine)
+	v_x1_s64r = ((s64)v_t_fine_s32)
 	- 128000;
 	v_x2_s64r = v_x1_s64r * v_x1_s64r *
-	(s64)p_bme280->cal_param.dig_P6;
+	(s64)p_cal->dig_P6;
 	v_x2_s64r = v_x2_s64r + ((v_x1_s64r *
-	(s64)p_bme280->cal_param.dig_P5)
+	(s64)p_cal->dig_P5)
 	<< BME280_SHIFT_BIT_POSITION_BY_17_BITS);
 	v_x2_s64r = v_x2_s64r +
-	(((s64)p_bme280->cal_param.dig_P4)
+	(((s64)p_cal->dig_P4)
 	<< BME280_SHIFT_BIT_POSITION_BY_35_BITS);
 	v_x1_s64r = ((v_x1_s64r * v_x1_s64r *
-	(s64)p_bme280->cal_param.dig_P3)
+	(s64)p_cal->dig_P3)
 	>> BME280_SHIFT_BIT_POSITION_BY_08_BITS) +
-	((v_x1_s64r * (s64)p_bme280->cal_param.dig_P2)
+	((v_x1_s64r * (s64)p_cal->dig_P2)
 	<< BME280_SHIFT_BIT_POSITION_BY_12_BITS);
 	v_x1_s64r = (((((s64)1)
 	<< BME280_SHIFT_BIT_POSITION_BY_47_BITS) + v_x1_s64r)) *
-	((s64)p_bme280->cal_param.dig_P1)
+	((s64)p_cal->dig_P1)
 	>> BME280_SHIFT_BIT_POSITION_BY_33_BITS;
 	pressure = 1048576 - v_uncom_pressure_s32;
 	/* Avoid exception caused by division by zero */
@@ -2159,19 +2746,42 @@ u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32)
 		#endif
 	else
 		return BME280_INVALID_DATA;
-	v_x1_s64r = (((s64)p_bme280->cal_param.dig_P9) *
+	v_x1_s64r = (((s64)p_cal->dig_P9) *
 	(pressure >> BME280_SHIFT_BIT_POSITION_BY_13_BITS) *
 	(pressure >> BME280_SHIFT_BIT_POSITION_BY_13_BITS))
 	>> BME280_SHIFT_BIT_POSITION_BY_25_BITS;
-	v_x2_s64r = (((s64)p_bme280->cal_param.dig_P8) *
+	v_x2_s64r = (((s64)p_cal->dig_P8) *
 	pressure) >> BME280_SHIFT_BIT_POSITION_BY_19_BITS;
 	pressure = (((pressure + v_x1_s64r +
 	v_x2_s64r) >> BME280_SHIFT_BIT_POSITION_BY_08_BITS) +
-	(((s64)p_bme280->cal_param.dig_P7)
+	(((s64)p_cal->dig_P7)
 	<< BME280_SHIFT_BIT_POSITION_BY_04_BITS));
 
 	return (u32)pressure;
 }
+/*!
+ * @brief Reads actual pressure from uncompensated pressure
+ * @note Returns the value in Pa as unsigned 32 bit
+ * integer in Q24.8 format (24 integer bits and
+ * 8 fractional bits).
+ * @note Output value of "24674867"
+ * represents 24674867 / 256 = 96386.2 Pa = 963.862 hPa
+ *
+ *
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param  v_uncom_pressure_s32 : value of uncompensated temperature
+ *
+ *
+ *  @return Return the actual pressure in u32
+ *
+*/
+u32 bme280_compensate_pressure_int64(
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32)
+{
+	return bme280_pressure_int64_kernel(&p_bme280->cal_param,
+	p_bme280->cal_param.t_fine, v_uncom_pressure_s32);
+}
 /*!
  * @brief Reads actual pressure from uncompensated pressure
  * @note Returns the value in Pa.
@@ -2180,6 +2790,7 @@ u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32)
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_pressure_s32 : value of uncompensated pressure
  *
  *
@@ -2187,22 +2798,56 @@ u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32)
  *
 */
 u32 bme280_compensate_pressure_int64_twentyfour_bit_output(
-s32 v_uncom_pressure_s32)
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32)
 {
 	u32 pressure = BME280_INIT_VALUE;
 
-	pressure = bme280_compensate_pressure_int64(
+	pressure = bme280_compensate_pressure_int64(p_bme280,
 	v_uncom_pressure_s32);
 	pressure = (u32)(pressure >> BME280_SHIFT_BIT_POSITION_BY_01_BIT);
 	return pressure;
 }
 #endif
+/*!
+ * @brief Computing one conversion time in microseconds
+ * from the timing constants given in 1/16 ms
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_init_u32 : time to start up the conversion
+ *  @param v_per_osrs_u32 : time of one oversampled conversion
+ *  @param v_setup_pressure_u32 : pressure setup time
+ *  @param v_setup_humidity_u32 : humidity setup time
+ *
+ *	@return the conversion time in microseconds
+ *
+ */
+static u32 bme280_measurement_time_usec(struct bme280_t *p_bme280,
+u32 v_init_u32, u32 v_per_osrs_u32,
+u32 v_setup_pressure_u32, u32 v_setup_humidity_u32)
+{
+	u32 v_time_sixteenth_ms_u32 = BME280_INIT_VALUE;
+
+	v_time_sixteenth_ms_u32 = v_init_u32 +
+	v_per_osrs_u32 *
+	(((1 << p_bme280->oversamp_temperature)
+	>> BME280_SHIFT_BIT_POSITION_BY_01_BIT)
+	+ ((1 << p_bme280->oversamp_pressure)
+	>> BME280_SHIFT_BIT_POSITION_BY_01_BIT) +
+	((1 << p_bme280->oversamp_humidity)
+	>> BME280_SHIFT_BIT_POSITION_BY_01_BIT))
+	+ ((p_bme280->oversamp_pressure > 0) ?
+	v_setup_pressure_u32 : 0) +
+	((p_bme280->oversamp_humidity > 0) ?
+	v_setup_humidity_u32 : 0);
+	return (v_time_sixteenth_ms_u32 * 1000 + 15) / 16;
+}
 /*!
  * @brief Computing waiting time for sensor data read
  *
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_delaytime_u8 : The value of delay time for force mode
  *
  *
@@ -2210,7 +2855,8 @@ s32 v_uncom_pressure_s32)
  *
  *
  */
-BME280_RETURN_FUNCTION_TYPE bme280_compute_wait_time(u8
+BME280_RETURN_FUNCTION_TYPE bme280_compute_wait_time(
+struct bme280_t *p_bme280, u8
 *v_delaytime_u8)
 {
 	/* used to return the communication result*/
@@ -2231,3 +2877,276 @@ BME280_RETURN_FUNCTION_TYPE bme280_compute_wait_time(u8
 	T_SETUP_HUMIDITY_MAX : 0) + 15) / 16;
 	return com_rslt;
 }
+/*!
+ * @brief Computing the maximum conversion time of one
+ * forced measurement in microseconds from the datasheet
+ * formula, without rounding up to whole milliseconds
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_time_u32 : The conversion time in microseconds
+ *
+ *
+ *	@retval 0 -> Success
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_compute_measurement_time_usec(
+struct bme280_t *p_bme280, u32 *v_time_u32)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+
+	*v_time_u32 = bme280_measurement_time_usec(p_bme280,
+	T_INIT_MAX, T_MEASURE_PER_OSRS_MAX,
+	T_SETUP_PRESSURE_MAX, T_SETUP_HUMIDITY_MAX);
+	return com_rslt;
+}
+/*!
+ * @brief Computing the typical conversion time of one
+ * forced measurement in microseconds. A conversion is
+ * not expected to be done earlier, so it is the time
+ * to sleep before polling with bme280_wait_ready()
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_time_u32 : The conversion time in microseconds
+ *
+ *
+ *	@retval 0 -> Success
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_compute_typical_measurement_time_usec(
+struct bme280_t *p_bme280, u32 *v_time_u32)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+
+	*v_time_u32 = bme280_measurement_time_usec(p_bme280,
+	T_INIT_TYP, T_MEASURE_PER_OSRS_TYP,
+	T_SETUP_PRESSURE_TYP, T_SETUP_HUMIDITY_TYP);
+	return com_rslt;
+}
+/*!
+ * @brief Computing the period of the data output in
+ * normal mode in microseconds: the typical conversion
+ * time of the oversampling settings plus the standby
+ * time of the config register. The oscillator of the
+ * sensor may be off by a few percent, so a reader
+ * polling at this period now and then sees the same
+ * conversion twice or misses one.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_period_u32 : The output period in microseconds
+ *
+ *
+ *	@retval 0 -> Success
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_compute_normal_mode_period_usec(
+struct bme280_t *p_bme280, u32 *v_period_u32)
+{
+	/* standby time of every t_sb setting in microseconds */
+	static const u32 v_standby_usec_u32[] = {
+	500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+
+	com_rslt = bme280_compute_typical_measurement_time_usec(p_bme280,
+	v_period_u32);
+	*v_period_u32 += v_standby_usec_u32[BME280_GET_BITSLICE(
+	p_bme280->config_reg, BME280_CONFIG_REG_TSB)];
+	return com_rslt;
+}
+/*!
+ * @brief Polls the status register 0xF3 until neither
+ * measuring (bit 3) nor im_update (bit 0) is set.
+ * Between two reads BME280_STATUS_POLL_INTERVAL_USEC is
+ * waited with bme280_wait_usec(). The timeout counts the
+ * time elapsed on the now_usec clock, or the nominal
+ * poll intervals when the device has no clock.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_timeout_usec_u32 : The longest time to poll
+ *
+ *	@note Usage Hint : bme280_wait_ready(p_bme280,
+ *	BME280_WAIT_READY_MARGIN_USEC)
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -4 -> Still busy after the timeout
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_wait_ready(
+struct bme280_t *p_bme280, u32 v_timeout_usec_u32)
+{
+	/* used to return the communication result*/
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 v_status_u8 = BME280_INIT_VALUE;
+	u32 v_waited_usec_u32 = BME280_INIT_VALUE;
+	u32 v_start_usec_u32 = BME280_INIT_VALUE;
+	/* check the p_bme280 structure pointer as NULL*/
+	if (p_bme280 == BME280_NULL)
+		return E_BME280_NULL_PTR;
+
+	if (p_bme280->now_usec != BME280_NULL)
+		v_start_usec_u32 = p_bme280->now_usec();
+	while (1) {
+		com_rslt = p_bme280->BME280_BUS_READ_FUNC(
+		p_bme280->dev_addr, BME280_STAT_REG,
+		&v_status_u8, BME280_GEN_READ_WRITE_DATA_LENGTH);
+		if (com_rslt != SUCCESS)
+			return com_rslt;
+		if ((v_status_u8 & (BME280_STAT_REG_MEASURING__MSK |
+		BME280_STAT_REG_IM_UPDATE__MSK)) == BME280_INIT_VALUE)
+			return SUCCESS;
+		/* sleeps and bus transfers may take longer than asked */
+		if (p_bme280->now_usec != BME280_NULL)
+			v_waited_usec_u32 = p_bme280->now_usec() -
+			v_start_usec_u32;
+		if (v_waited_usec_u32 >= v_timeout_usec_u32)
+			return E_BME280_TIMEOUT;
+		bme280_wait_usec(p_bme280, BME280_STATUS_POLL_INTERVAL_USEC);
+		if (p_bme280->now_usec == BME280_NULL)
+			v_waited_usec_u32 +=
+			BME280_STATUS_POLL_INTERVAL_USEC;
+	}
+}
+/*!
+ * @brief Waits the given time with delay_usec, or with
+ * delay_msec rounded up to whole milliseconds when the
+ * microsecond delay is not provided
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_time_u32 : The time to wait in microseconds
+ *
+ *
+ */
+void bme280_wait_usec(struct bme280_t *p_bme280, u32 v_time_u32)
+{
+	if (p_bme280->delay_usec != BME280_NULL)
+		p_bme280->delay_usec(v_time_u32);
+	else
+		p_bme280->delay_msec((v_time_u32 + 999) / 1000);
+}
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity with the 32 bit integer formulas.
+ * t_fine is passed between the formulas internally, the
+ * device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in 0.01 DegC, pressure in Pa and
+ *  humidity in Q22.10 %rH
+ *
+*/
+struct bme280_compensated_int32_t bme280_compensate_all_int32(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32)
+{
+	struct bme280_compensated_int32_t result;
+	s32 v_t_fine_s32 = BME280_INIT_VALUE;
+
+	result.temperature = bme280_temperature_int32_kernel(
+	&p_bme280->cal_param, v_uncom_temperature_s32, &v_t_fine_s32);
+	result.pressure = bme280_pressure_int32_kernel(
+	&p_bme280->cal_param, v_t_fine_s32, v_uncom_pressure_s32);
+	result.humidity = bme280_humidity_int32_kernel(
+	&p_bme280->cal_param, v_t_fine_s32, v_uncom_humidity_s32);
+	return result;
+}
+#if defined(BME280_ENABLE_INT64) && defined(BME280_64BITSUPPORT_PRESENT)
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity, the pressure with the 64 bit
+ * integer formula. The device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in 0.01 DegC, pressure in Q24.8 Pa and
+ *  humidity in Q22.10 %rH
+ *
+*/
+struct bme280_compensated_int64_t bme280_compensate_all_int64(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32)
+{
+	struct bme280_compensated_int64_t result;
+	s32 v_t_fine_s32 = BME280_INIT_VALUE;
+
+	result.temperature = bme280_temperature_int32_kernel(
+	&p_bme280->cal_param, v_uncom_temperature_s32, &v_t_fine_s32);
+	result.pressure = bme280_pressure_int64_kernel(
+	&p_bme280->cal_param, v_t_fine_s32, v_uncom_pressure_s32);
+	result.humidity = bme280_humidity_int32_kernel(
+	&p_bme280->cal_param, v_t_fine_s32, v_uncom_humidity_s32);
+	return result;
+}
+#endif
+#ifdef BME280_ENABLE_FLOAT
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity in double precision.
+ * The device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in DegC, pressure in Pa and humidity in %rH
+ *
+*/
+struct bme280_compensated_double_t bme280_compensate_all_double(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32)
+{
+	struct bme280_compensated_double_t result;
+	s32 v_t_fine_s32 = BME280_INIT_VALUE;
+
+	result.temperature = bme280_temperature_double_kernel(
+	&p_bme280->double_coeff, v_uncom_temperature_s32, &v_t_fine_s32);
+	result.pressure = bme280_pressure_double_kernel(
+	&p_bme280->double_coeff, v_t_fine_s32, v_uncom_pressure_s32);
+	result.humidity = bme280_humidity_double_kernel(
+	&p_bme280->double_coeff, v_t_fine_s32, v_uncom_humidity_s32);
+	return result;
+}
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity in single precision.
+ * The device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in DegC, pressure in Pa and humidity in %rH
+ *
+*/
+struct bme280_compensated_float_t bme280_compensate_all_float(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32)
+{
+	struct bme280_compensated_float_t result;
+	s32 v_t_fine_s32 = BME280_INIT_VALUE;
+
+	result.temperature = bme280_temperature_float_kernel(
+	&p_bme280->float_coeff, v_uncom_temperature_s32, &v_t_fine_s32);
+	result.pressure = bme280_pressure_float_kernel(
+	&p_bme280->float_coeff, v_t_fine_s32, v_uncom_pressure_s32);
+	result.humidity = bme280_humidity_float_kernel(
+	&p_bme280->float_coeff, v_t_fine_s32, v_uncom_humidity_s32);
+	return result;
+}
+#endif
@@ -0,0 +1,332 @@
+/*
+ * File:   bme280_sampler.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Batched sampling of several BME280 sensors sharing one bus.
+ */
+
+#include "bme280_sampler.h"
+
+static BME280_RETURN_FUNCTION_TYPE bme280_sampler_select(
+struct bme280_sampler_sensor_t *sensor)
+{
+	if (sensor->select == BME280_NULL)
+		return SUCCESS;
+	return sensor->select(sensor->select_context,
+	sensor->device->dev_addr);
+}
+
+/* Starts the timing of a sensor over: the last conversion ended in
+(v_first_usec_u32, v_last_usec_u32], and the output period is within
+the difference of maximum and typical conversion time around the
+typical period. */
+static void bme280_sampler_timing_reset(
+struct bme280_sampler_sensor_t *sensor, u32 v_first_usec_u32,
+u32 v_last_usec_u32)
+{
+	struct bme280_sampler_timing_t *timing = &sensor->timing;
+	u32 v_period_usec_u32 = BME280_INIT_VALUE;
+	u32 v_typ_usec_u32 = BME280_INIT_VALUE;
+	u32 v_max_usec_u32 = BME280_INIT_VALUE;
+
+	bme280_compute_normal_mode_period_usec(sensor->device,
+	&v_period_usec_u32);
+	bme280_compute_typical_measurement_time_usec(sensor->device,
+	&v_typ_usec_u32);
+	bme280_compute_measurement_time_usec(sensor->device,
+	&v_max_usec_u32);
+
+	timing->end_min_usec = v_first_usec_u32;
+	timing->end_max_usec = v_last_usec_u32;
+	timing->anchor_min_usec = v_first_usec_u32;
+	timing->anchor_max_usec = v_last_usec_u32;
+	timing->period_min_usec = v_period_usec_u32 -
+	(v_max_usec_u32 - v_typ_usec_u32);
+	timing->period_max_usec = v_period_usec_u32 +
+	(v_max_usec_u32 - v_typ_usec_u32);
+	timing->conversions = BME280_INIT_VALUE;
+	timing->is_valid = 1;
+}
+
+/* Time from v_end_usec_u32 until the next conversion has surely
+ended, at least 1 us, if the read from v_start_usec_u32 to
+v_end_usec_u32 may have come before or after its end, and half an
+output period at most; 0 if the read came surely before or after
+it. */
+static u32 bme280_sampler_timing_settle(
+struct bme280_sampler_sensor_t *sensor, u32 v_start_usec_u32,
+u32 v_end_usec_u32)
+{
+	struct bme280_sampler_timing_t *timing = &sensor->timing;
+	s32 v_left_usec_s32 = BME280_INIT_VALUE;
+
+	if (!timing->is_valid ||
+	(s32)(v_end_usec_u32 - timing->end_min_usec -
+	timing->period_min_usec) <= 0 ||
+	(s32)(v_start_usec_u32 - timing->end_max_usec -
+	timing->period_max_usec) >= 0)
+		return BME280_INIT_VALUE;
+	v_left_usec_s32 = (s32)(timing->end_max_usec +
+	timing->period_max_usec - v_end_usec_u32);
+	if (v_left_usec_s32 > (s32)(timing->period_min_usec >> 1))
+		return BME280_INIT_VALUE;
+	/* a read that ended after it may still have started before */
+	return (v_left_usec_s32 > 0) ? (u32)v_left_usec_s32 : 1;
+}
+
+/* Decides whether the frame latched during the read from
+v_start_usec_u32 to v_end_usec_u32 comes from a new conversion, and
+narrows the bounds with the answer. */
+static u8 bme280_sampler_timing_update(
+struct bme280_sampler_sensor_t *sensor, u8 v_is_equal_u8,
+u32 v_start_usec_u32, u32 v_end_usec_u32)
+{
+	struct bme280_sampler_timing_t *timing = &sensor->timing;
+	u32 v_next_min_usec_u32 = BME280_INIT_VALUE;
+	u32 v_next_max_usec_u32 = BME280_INIT_VALUE;
+	u32 v_bound_usec_u32 = BME280_INIT_VALUE;
+	u8 v_is_new_u8 = 1;
+
+	if (!timing->is_valid) {
+		/* a running sensor ended a conversion within a period */
+		bme280_sampler_timing_reset(sensor, v_end_usec_u32,
+		v_end_usec_u32);
+		timing->end_min_usec -= timing->period_max_usec;
+		timing->anchor_min_usec = timing->end_min_usec;
+		timing->read_start_usec = v_start_usec_u32;
+		return v_is_equal_u8;
+	}
+
+	/* the next conversion ends in (next_min, next_max] */
+	v_next_min_usec_u32 = timing->end_min_usec +
+	timing->period_min_usec;
+	v_next_max_usec_u32 = timing->end_max_usec +
+	timing->period_max_usec;
+	/* an equal frame is new only if the next conversion surely
+	ended before the read, most equal frames are read twice */
+	v_is_new_u8 = !v_is_equal_u8 ||
+	(s32)(v_start_usec_u32 - v_next_max_usec_u32) >= 0;
+
+	if (v_is_new_u8) {
+		/* the conversion ended after the read before was started
+		and at the latest when this one was done */
+		if ((s32)(v_next_min_usec_u32 - timing->read_start_usec) < 0)
+			v_next_min_usec_u32 = timing->read_start_usec;
+		if ((s32)(v_next_max_usec_u32 - v_end_usec_u32) > 0)
+			v_next_max_usec_u32 = v_end_usec_u32;
+		if ((s32)(v_next_max_usec_u32 - v_next_min_usec_u32) <= 0) {
+			bme280_sampler_timing_reset(sensor,
+			timing->read_start_usec, v_end_usec_u32);
+			timing->read_start_usec = v_start_usec_u32;
+			return BME280_INIT_VALUE;
+		}
+		timing->end_min_usec = v_next_min_usec_u32;
+		timing->end_max_usec = v_next_max_usec_u32;
+		timing->conversions++;
+		/* the period times the conversions since the anchor spans
+		the two ends, its bounds tighten with every conversion */
+		v_bound_usec_u32 = (timing->end_max_usec -
+		timing->anchor_min_usec + timing->conversions - 1) /
+		timing->conversions;
+		if (v_bound_usec_u32 < timing->period_max_usec)
+			timing->period_max_usec = v_bound_usec_u32;
+		v_bound_usec_u32 = (timing->end_min_usec -
+		timing->anchor_max_usec) / timing->conversions;
+		if ((s32)(timing->end_min_usec -
+		timing->anchor_max_usec) > 0 &&
+		v_bound_usec_u32 > timing->period_min_usec)
+			timing->period_min_usec = v_bound_usec_u32;
+		/* the period bounds stay, a tighter anchor tightens them
+		faster from here on */
+		if (timing->conversions >= BME280_SAMPLER_ANCHOR_CONVERSIONS ||
+		timing->end_max_usec - timing->end_min_usec <
+		timing->anchor_max_usec - timing->anchor_min_usec) {
+			timing->anchor_min_usec = timing->end_min_usec;
+			timing->anchor_max_usec = timing->end_max_usec;
+			timing->conversions = BME280_INIT_VALUE;
+		}
+	} else {
+		/* no conversion ended before the read was started */
+		v_bound_usec_u32 = v_start_usec_u32 - timing->end_max_usec;
+		if ((s32)(v_start_usec_u32 - timing->end_max_usec) > 0 &&
+		v_bound_usec_u32 > timing->period_min_usec)
+			timing->period_min_usec = v_bound_usec_u32;
+		v_bound_usec_u32 = v_start_usec_u32 - timing->period_max_usec;
+		if ((s32)(v_bound_usec_u32 - timing->end_min_usec) > 0)
+			timing->end_min_usec = v_bound_usec_u32;
+	}
+	/* the sensor drifted off the bounds, start them over */
+	if (timing->period_min_usec > timing->period_max_usec ||
+	(s32)(timing->end_max_usec - timing->end_min_usec) <= 0)
+		timing->is_valid = BME280_INIT_VALUE;
+	timing->read_start_usec = v_start_usec_u32;
+	return !v_is_new_u8;
+}
+
+/* Reads the frame of a sensor in normal mode and flags it repeated.
+An equal frame read while the next conversion may just have ended is
+read again once it surely has: a frame that differs then shows the
+first one was repeated, an equal one that one conversion of equal
+values ended. */
+static BME280_RETURN_FUNCTION_TYPE bme280_sampler_read_normal(
+struct bme280_sampler_sensor_t *sensor)
+{
+	BME280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	s32 a_last_frame_s32[3];
+	u32 v_start_usec_u32 = BME280_INIT_VALUE;
+	u32 v_end_usec_u32 = BME280_INIT_VALUE;
+	u32 v_restart_usec_u32 = BME280_INIT_VALUE;
+	u32 v_waittime_u32 = BME280_INIT_VALUE;
+	u8 v_is_equal_u8 = BME280_INIT_VALUE;
+
+	a_last_frame_s32[0] = sensor->uncomp_pressure;
+	a_last_frame_s32[1] = sensor->uncomp_temperature;
+	a_last_frame_s32[2] = sensor->uncomp_humidity;
+	v_start_usec_u32 = sensor->device->now_usec();
+	com_rslt = bme280_read_uncomp_pressure_temperature_humidity(
+	sensor->device, &sensor->uncomp_pressure,
+	&sensor->uncomp_temperature, &sensor->uncomp_humidity);
+	if (com_rslt != SUCCESS)
+		return com_rslt;
+	v_end_usec_u32 = sensor->device->now_usec();
+	v_is_equal_u8 = a_last_frame_s32[0] == sensor->uncomp_pressure &&
+	a_last_frame_s32[1] == sensor->uncomp_temperature &&
+	a_last_frame_s32[2] == sensor->uncomp_humidity;
+
+	if (v_is_equal_u8)
+		v_waittime_u32 = bme280_sampler_timing_settle(sensor,
+		v_start_usec_u32, v_end_usec_u32);
+	if (v_waittime_u32 > BME280_INIT_VALUE) {
+		bme280_wait_usec(sensor->device, v_waittime_u32);
+		v_restart_usec_u32 = sensor->device->now_usec();
+		com_rslt = bme280_read_uncomp_pressure_temperature_humidity(
+		sensor->device, &sensor->uncomp_pressure,
+		&sensor->uncomp_temperature, &sensor->uncomp_humidity);
+		if (com_rslt != SUCCESS)
+			return com_rslt;
+		v_is_equal_u8 = a_last_frame_s32[0] ==
+		sensor->uncomp_pressure &&
+		a_last_frame_s32[1] == sensor->uncomp_temperature &&
+		a_last_frame_s32[2] == sensor->uncomp_humidity;
+		if (!v_is_equal_u8)
+			bme280_sampler_timing_update(sensor, 1,
+			v_start_usec_u32, v_end_usec_u32);
+		v_start_usec_u32 = v_restart_usec_u32;
+		v_end_usec_u32 = sensor->device->now_usec();
+	}
+	sensor->is_repeated = bme280_sampler_timing_update(sensor,
+	v_is_equal_u8, v_start_usec_u32, v_end_usec_u32);
+	return com_rslt;
+}
+
+BME280_RETURN_FUNCTION_TYPE bme280_sampler_add(
+struct bme280_sampler_t *sampler, struct bme280_t *device,
+bme280_sampler_select_t select, void *select_context, u8 *v_index_u8)
+{
+	struct bme280_sampler_sensor_t *sensor;
+
+	if (sampler == BME280_NULL || device == BME280_NULL)
+		return E_BME280_NULL_PTR;
+	if (sampler->sensor_count >= BME280_SAMPLER_MAX_SENSORS)
+		return E_BME280_OUT_OF_RANGE;
+
+	sensor = &sampler->sensors[sampler->sensor_count];
+	sensor->device = device;
+	sensor->select = select;
+	sensor->select_context = select_context;
+	sensor->uncomp_pressure = BME280_INIT_VALUE;
+	sensor->uncomp_temperature = BME280_INIT_VALUE;
+	sensor->uncomp_humidity = BME280_INIT_VALUE;
+	sensor->result = ERROR;
+	sensor->is_repeated = BME280_INIT_VALUE;
+	sensor->timing.is_valid = BME280_INIT_VALUE;
+
+	if (v_index_u8 != BME280_NULL)
+		*v_index_u8 = sampler->sensor_count;
+	sampler->sensor_count++;
+
+	return SUCCESS;
+}
+
+BME280_RETURN_FUNCTION_TYPE bme280_sampler_run(
+struct bme280_sampler_t *sampler)
+{
+	BME280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	struct bme280_sampler_sensor_t *sensor;
+	struct bme280_t *p_slowest_device = BME280_NULL;
+	u32 v_waittime_u32 = BME280_INIT_VALUE;
+	u32 v_max_waittime_u32 = BME280_INIT_VALUE;
+	u32 v_typ_waittime_u32 = BME280_INIT_VALUE;
+	u8 v_index_u8 = BME280_INIT_VALUE;
+
+	if (sampler == BME280_NULL)
+		return E_BME280_NULL_PTR;
+
+	/* trigger every sensor before waiting for any of them */
+	for (v_index_u8 = 0; v_index_u8 < sampler->sensor_count;
+	v_index_u8++) {
+		sensor = &sampler->sensors[v_index_u8];
+		if (BME280_GET_BITSLICE(sensor->device->ctrl_meas_reg,
+		BME280_CTRL_MEAS_REG_POWER_MODE) == BME280_NORMAL_MODE) {
+			/* data registers are updated by the sensor itself */
+			sensor->result = SUCCESS;
+			continue;
+		}
+		sensor->result = bme280_sampler_select(sensor);
+		if (sensor->result == SUCCESS)
+			sensor->result = bme280_trigger_forced_measurement(
+			sensor->device);
+
+		bme280_compute_measurement_time_usec(sensor->device,
+		&v_waittime_u32);
+		if (v_waittime_u32 > v_max_waittime_u32) {
+			v_max_waittime_u32 = v_waittime_u32;
+			p_slowest_device = sensor->device;
+		}
+	}
+
+	/* one sleep covers the typical time of the longest conversion,
+	the status of every sensor is polled for the rest of it */
+	if (p_slowest_device != BME280_NULL) {
+		bme280_compute_typical_measurement_time_usec(
+		p_slowest_device, &v_typ_waittime_u32);
+		bme280_wait_usec(p_slowest_device, v_typ_waittime_u32);
+	}
+
+	/* burst read all data frames back to back */
+	for (v_index_u8 = 0; v_index_u8 < sampler->sensor_count;
+	v_index_u8++) {
+		sensor = &sampler->sensors[v_index_u8];
+		if (sensor->result != SUCCESS) {
+			com_rslt = ERROR;
+			continue;
+		}
+		sensor->result = bme280_sampler_select(sensor);
+		if (sensor->result == SUCCESS &&
+		BME280_GET_BITSLICE(sensor->device->ctrl_meas_reg,
+		BME280_CTRL_MEAS_REG_POWER_MODE) != BME280_NORMAL_MODE)
+			sensor->result = bme280_wait_ready(sensor->device,
+			v_max_waittime_u32 - v_typ_waittime_u32 +
+			BME280_WAIT_READY_MARGIN_USEC);
+		if (sensor->result != SUCCESS) {
+			com_rslt = ERROR;
+			continue;
+		}
+		sensor->is_repeated = BME280_INIT_VALUE;
+		/* the data registers keep the last conversion until the
+		next one ends, but two conversions often give equal raw
+		values at x1, so equal frames are decided by the time */
+		if (sensor->device->now_usec != BME280_NULL &&
+		BME280_GET_BITSLICE(sensor->device->ctrl_meas_reg,
+		BME280_CTRL_MEAS_REG_POWER_MODE) == BME280_NORMAL_MODE)
+			sensor->result = bme280_sampler_read_normal(sensor);
+		else
+			sensor->result =
+			bme280_read_uncomp_pressure_temperature_humidity(
+			sensor->device, &sensor->uncomp_pressure,
+			&sensor->uncomp_temperature, &sensor->uncomp_humidity);
+		if (sensor->result != SUCCESS)
+			com_rslt = ERROR;
+	}
+	return com_rslt;
+}
@@ -464,11 +464,14 @@ BME280_BUS_RD_PARAM_TYPE to function calls used inside the API
 /* numeric definitions */
 #define	BME280_PRESSURE_TEMPERATURE_CALIB_DATA_LENGTH	    (26)
 #define	BME280_HUMIDITY_CALIB_DATA_LENGTH	    (7)
+#define	BME280_CALIB_PROBE_DATA_LENGTH	    (6)
 #define	BME280_GEN_READ_WRITE_DATA_LENGTH		(1)
 #define	BME280_HUMIDITY_DATA_LENGTH				(2)
 #define	BME280_TEMPERATURE_DATA_LENGTH			(3)
 #define	BME280_PRESSURE_DATA_LENGTH				(3)
 #define	BME280_ALL_DATA_FRAME_LENGTH			(8)
+#define	BME280_CTRL_REGISTERS_DATA_LENGTH		(4)
+#define	BME280_CONFIG_BURST_WRITE_DATA_LENGTH	(7)
 #define	BME280_INIT_VALUE				(0)
 #define	BME280_CHIP_ID_READ_COUNT			(5)
 #define	BME280_INVALID_DATA				(0)
@@ -480,9 +483,13 @@ BME280_BUS_RD_PARAM_TYPE to function calls used inside the API
 #define E_BME280_NULL_PTR       ((s8)-127)
 #define E_BME280_COMM_RES       ((s8)-1)
 #define E_BME280_OUT_OF_RANGE   ((s8)-2)
+#define E_BME280_VERIFY_FAIL    ((s8)-3)
+#define E_BME280_TIMEOUT        ((s8)-4)
 #define ERROR					((s8)-1)
 #define BME280_CHIP_ID_READ_FAIL	((s8)-1)
 #define BME280_CHIP_ID_READ_SUCCESS	((u8)0)
+#define BME280_CALIB_CACHE_MISS	((u8)0)
+#define BME280_CALIB_CACHE_HIT	((u8)1)
 
 /****************************************************/
 /**\name	CHIP ID DEFINITIONS  */
@@ -503,6 +510,16 @@ BME280_BUS_RD_PARAM_TYPE to function calls used inside the API
 #define BME280_NORMAL_MODE                   (0x03)
 #define BME280_SOFT_RESET_CODE               (0xB6)
 /****************************************************/
+/**\name	SHADOW REGISTER DEFINITIONS  */
+/***************************************************/
+#define BME280_SHADOW_MODE_DISABLE           (0x00)
+#define BME280_SHADOW_MODE_ENABLE            (0x01)
+/****************************************************/
+/**\name	CONFIGURATION VERIFY DEFINITIONS  */
+/***************************************************/
+#define BME280_CONFIG_VERIFY_DISABLE         (0x00)
+#define BME280_CONFIG_VERIFY_ENABLE          (0x01)
+/****************************************************/
 /**\name	STANDBY DEFINITIONS  */
 /***************************************************/
 #define BME280_STANDBY_TIME_1_MS              (0x00)
@@ -568,6 +585,23 @@ BME280_BUS_RD_PARAM_TYPE to function calls used inside the API
 
 #define T_SETUP_HUMIDITY_MAX                   (10)
 		/* 10/16 = 0.625 ms */
+
+#define T_INIT_TYP                             (16)
+		/* 16/16 = 1 ms */
+#define T_MEASURE_PER_OSRS_TYP                 (32)
+		/* 32/16 = 2 ms */
+#define T_SETUP_PRESSURE_TYP                   (8)
+		/* 8/16 = 0.5 ms */
+#define T_SETUP_HUMIDITY_TYP                   (8)
+		/* 8/16 = 0.5 ms */
+
+/* every status read is a bus transfer, 0.5 ms keeps the bus free */
+#define BME280_STATUS_POLL_INTERVAL_USEC       (500)
+/****************************************************/
+/**\name	BATCH COMPENSATION DEFINITIONS  */
+/***************************************************/
+#define BME280_BATCH_CHUNK_SIZE                (32)
+#define BME280_WAIT_READY_MARGIN_USEC          (1000)
 /****************************************************/
 /**\name	DEFINITIONS FOR ARRAY SIZE OF DATA   */
 /***************************************************/
@@ -578,6 +612,11 @@ BME280_BUS_RD_PARAM_TYPE to function calls used inside the API
 /**< data frames includes temperature,
 pressure and humidity*/
 #define	BME280_CALIB_DATA_SIZE			(26)
+#define	BME280_CTRL_REGISTERS_SIZE		(4)
+#define	BME280_CALIB_PROBE_SIZE			(6)
+/**< dig_T1 to dig_T3, compared against a cached calibration*/
+/**< control humidity, status, control measurement
+and configuration registers*/
 
 #define	BME280_TEMPERATURE_MSB_DATA		(0)
 #define	BME280_TEMPERATURE_LSB_DATA		(1)
@@ -596,6 +635,17 @@ pressure and humidity*/
 #define	BME280_DATA_FRAME_TEMPERATURE_XLSB_BYTE	(5)
 #define	BME280_DATA_FRAME_HUMIDITY_MSB_BYTE		(6)
 #define	BME280_DATA_FRAME_HUMIDITY_LSB_BYTE		(7)
+
+#define	BME280_CTRL_REGISTERS_HUMIDITY_BYTE		(0)
+#define	BME280_CTRL_REGISTERS_MEAS_BYTE			(2)
+#define	BME280_CTRL_REGISTERS_CONFIG_BYTE		(3)
+
+#define	BME280_FORCED_TRIGGER_SIZE			(3)
+/**< control measurement value for sleep, then
+register/value pair for forced mode*/
+#define	BME280_CONFIG_BURST_SIZE			(8)
+/**< register/value pairs for control measurement (sleep),
+control humidity, configuration and control measurement*/
 /****************************************************/
 /**\name	ARRAY PARAMETER FOR CALIBRATION     */
 /***************************************************/
@@ -788,6 +838,7 @@ FOR PRESSURE AND TEMPERATURE DATA  */
 		u8 *, u8)
 
 #define BME280_MDELAY_DATA_TYPE u32
+#define BME280_UDELAY_DATA_TYPE u32
 
 #define	BME280_3MS_DELAY	(3)
 #define BME280_REGISTER_READ_DELAY (1)
@@ -820,12 +871,122 @@ struct bme280_calibration_param_t {
 
 	s32 t_fine;/**<calibration T_FINE data*/
 };
+#ifdef BME280_ENABLE_FLOAT
+/*!
+ * @brief This structure holds the calibration parameters converted
+ * to double and pre-scaled by the powers of two of the double
+ * compensation formulas, so the results stay bit identical
+ */
+struct bme280_double_coeff_t {
+	double t1;/**<dig_T1 / 2^13*/
+	double t2;/**<dig_T2 * 2^3*/
+	double t3;/**<dig_T3*/
+
+	double p1;/**<dig_P1*/
+	double p2;/**<dig_P2 / 2^34*/
+	double p3;/**<dig_P3 / 2^53*/
+	double p4;/**<dig_P4 * 2^4*/
+	double p5;/**<dig_P5 / 2^13*/
+	double p6;/**<dig_P6 / 2^29*/
+	double p7;/**<dig_P7 / 2^4*/
+	double p8;/**<dig_P8 / 2^19*/
+	double p9;/**<dig_P9 / 2^35*/
+
+	double h1;/**<dig_H1 / 2^19*/
+	double h2;/**<dig_H2 / 2^16*/
+	double h3;/**<dig_H3 / 2^26*/
+	double h4;/**<dig_H4 * 2^6*/
+	double h5;/**<dig_H5 / 2^14*/
+	double h6;/**<dig_H6 / 2^26*/
+};
+/*!
+ * @brief This structure holds the same coefficients as
+ * bme280_double_coeff_t in single precision, dig_T1 is kept
+ * as an integer offset of the uncompensated temperature
+ */
+struct bme280_float_coeff_t {
+	s32 t1;/**<dig_T1 * 2^4*/
+	float t2;/**<dig_T2 / 2^14*/
+	float t3;/**<dig_T3 / 2^34*/
+
+	float p1;/**<dig_P1*/
+	float p2;/**<dig_P2 / 2^34*/
+	float p3;/**<dig_P3 / 2^53*/
+	float p4;/**<dig_P4 * 2^4*/
+	float p5;/**<dig_P5 / 2^13*/
+	float p6;/**<dig_P6 / 2^29*/
+	float p7;/**<dig_P7 / 2^4*/
+	float p8;/**<dig_P8 / 2^19*/
+	float p9;/**<dig_P9 / 2^35*/
+
+	float h1;/**<dig_H1 / 2^19*/
+	float h2;/**<dig_H2 / 2^16*/
+	float h3;/**<dig_H3 / 2^26*/
+	float h4;/**<dig_H4 * 2^6*/
+	float h5;/**<dig_H5 / 2^14*/
+	float h6;/**<dig_H6 / 2^26*/
+};
+#endif
+/*!
+ * @brief Result of bme280_compensate_all_int32()
+ */
+struct bme280_compensated_int32_t {
+	s32 temperature;/**< temperature in 0.01 DegC*/
+	u32 pressure;/**< pressure in Pa*/
+	u32 humidity;/**< humidity in Q22.10 %rH*/
+};
+#if defined(BME280_ENABLE_INT64) && defined(BME280_64BITSUPPORT_PRESENT)
+/*!
+ * @brief Result of bme280_compensate_all_int64()
+ */
+struct bme280_compensated_int64_t {
+	s32 temperature;/**< temperature in 0.01 DegC*/
+	u32 pressure;/**< pressure in Q24.8 Pa*/
+	u32 humidity;/**< humidity in Q22.10 %rH*/
+};
+#endif
+#ifdef BME280_ENABLE_FLOAT
+/*!
+ * @brief Result of bme280_compensate_all_double()
+ */
+struct bme280_compensated_double_t {
+	double temperature;/**< temperature in DegC*/
+	double pressure;/**< pressure in Pa*/
+	double humidity;/**< humidity in %rH*/
+};
+/*!
+ * @brief Result of bme280_compensate_all_float()
+ */
+struct bme280_compensated_float_t {
+	float temperature;/**< temperature in DegC*/
+	float pressure;/**< pressure in Pa*/
+	float humidity;/**< humidity in %rH*/
+};
+#endif
+/*!
+ * @brief This structure holds a complete sensor configuration
+ * applied at once by bme280_apply_config()
+ */
+struct bme280_config_t {
+	u8 oversamp_temperature;/**< temperature over sampling*/
+	u8 oversamp_pressure;/**< pressure over sampling*/
+	u8 oversamp_humidity;/**< humidity over sampling*/
+	u8 power_mode;/**< power mode entered after the write*/
+	u8 standby_durn;/**< standby duration in normal mode*/
+	u8 filter;/**< IIR filter coefficient*/
+};
 /*!
  * @brief This structure holds BME280 initialization parameters
  */
 struct bme280_t {
 	struct bme280_calibration_param_t cal_param;
 	/**< calibration parameters*/
+#ifdef BME280_ENABLE_FLOAT
+	struct bme280_double_coeff_t double_coeff;
+	/**< calibration parameters for the double compensation*/
+	struct bme280_float_coeff_t float_coeff;
+	/**< calibration parameters for the float compensation*/
+#endif
 
 	u8 chip_id;/**< chip id of the sensor*/
 	u8 dev_addr;/**< device address of the sensor*/
@@ -836,10 +997,18 @@ struct bme280_t {
 	u8 ctrl_hum_reg;/**< status of control humidity register*/
 	u8 ctrl_meas_reg;/**< status of control measurement register*/
 	u8 config_reg;/**< status of configuration register*/
+	u8 shadow_mode;
+	/**< BME280_SHADOW_MODE_ENABLE: trust the three registers above
+	instead of reading them back from the sensor*/
 
 	BME280_WR_FUNC_PTR;/**< bus write function pointer*/
 	BME280_RD_FUNC_PTR;/**< bus read function pointer*/
 	void (*delay_msec)(BME280_MDELAY_DATA_TYPE);/**< delay function pointer*/
+	void (*delay_usec)(BME280_UDELAY_DATA_TYPE);
+	/**< microsecond delay function pointer, may be BME280_NULL*/
+	u32 (*now_usec)(void);
+	/**< free running microsecond clock that may wrap,
+	may be BME280_NULL*/
 };
 /**************************************************************/
 /**\name	FUNCTION DECLARATIONS                         */
@@ -852,8 +1021,14 @@ struct bme280_t {
  *	the bus read and bus write functions
  *  and assign the chip id and I2C address of the BME280 sensor
  *	chip id is read in the register 0xD0 bit from 0 to 7
+ *	and the registers 0xF2 to 0xF5 are read into the cached
+ *	control registers
+ *
+ *	 @param p_bme280 : pointer to the bme280 device structure
  *
- *	 @param bme280 structure pointer.
+ *	@note With shadow_mode set to BME280_SHADOW_MODE_ENABLE the
+ *	setters trust the cached control registers and skip the read
+ *	back; the registers must then only be changed through this driver
  *
  *	@note While changing the parameter of the bme280_t
  *	@note consider the following point:
@@ -872,7 +1047,7 @@ struct bme280_t {
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280);
+BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *p_bme280);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION UNCOMPENSATED TEMPERATURE */
 /**************************************************************/
@@ -883,6 +1058,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280);
  *	@note 0xFB -> LSB -> bit from 0 to 7
  *	@note 0xFC -> LSB -> bit from 4 to 7
  *
+ * @param p_bme280 : pointer to the bme280 device structure
  * @param v_uncomp_temperature_s32 : The value of uncompensated temperature
  *
  *
@@ -894,7 +1070,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_init(struct bme280_t *bme280);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_temperature(
-s32 *v_uncomp_temperature_s32);
+struct bme280_t *p_bme280, s32 *v_uncomp_temperature_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION TRUE TEMPERATURE */
 /**************************************************************/
@@ -905,19 +1081,22 @@ s32 *v_uncomp_temperature_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_uncomp_temperature_s32 : value of uncompensated temperature
  *
  *
  *  @return Returns the actual temperature
  *
 */
-s32 bme280_compensate_temperature_int32(s32 v_uncomp_temperature_s32);
+s32 bme280_compensate_temperature_int32(
+struct bme280_t *p_bme280, s32 v_uncomp_temperature_s32);
 /*!
  * @brief Reads actual temperature from uncompensated temperature
  * @note Returns the value with 500LSB/DegC centred around 24 DegC
  * output value of "5123" equals(5123/500)+24 = 34.246DegC
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncomp_temperature_s32: value of uncompensated temperature
  *
  *
@@ -926,7 +1105,7 @@ s32 bme280_compensate_temperature_int32(s32 v_uncomp_temperature_s32);
  *
 */
 s16 bme280_compensate_temperature_int32_sixteen_bit_output(
-s32 v_uncomp_temperature_s32);
+struct bme280_t *p_bme280, s32 v_uncomp_temperature_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION UNCOMPENSATED PRESSURE */
 /**************************************************************/
@@ -939,6 +1118,7 @@ s32 v_uncomp_temperature_s32);
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_uncomp_pressure_s32 : The value of uncompensated pressure
  *
  *
@@ -950,7 +1130,7 @@ s32 v_uncomp_temperature_s32);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_pressure(
-s32 *v_uncomp_pressure_s32);
+struct bme280_t *p_bme280, s32 *v_uncomp_pressure_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION TRUE PRESSURE */
 /**************************************************************/
@@ -962,6 +1142,7 @@ s32 *v_uncomp_pressure_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncomp_pressure_s32 : value of uncompensated pressure
  *
  *
@@ -969,7 +1150,8 @@ s32 *v_uncomp_pressure_s32);
  *  @return Return the actual pressure output as u32
  *
 */
-u32 bme280_compensate_pressure_int32(s32 v_uncomp_pressure_s32);
+u32 bme280_compensate_pressure_int32(
+struct bme280_t *p_bme280, s32 v_uncomp_pressure_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION UNCOMPENSATED HUMIDITY */
 /**************************************************************/
@@ -981,6 +1163,7 @@ u32 bme280_compensate_pressure_int32(s32 v_uncomp_pressure_s32);
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_uncomp_humidity_s32 : The value of uncompensated humidity
  *
  *
@@ -992,7 +1175,7 @@ u32 bme280_compensate_pressure_int32(s32 v_uncomp_pressure_s32);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_humidity(
-s32 *v_uncomp_humidity_s32);
+struct bme280_t *p_bme280, s32 *v_uncomp_humidity_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION RELATIVE HUMIDITY */
 /**************************************************************/
@@ -1005,12 +1188,53 @@ s32 *v_uncomp_humidity_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_uncomp_humidity_s32: value of uncompensated humidity
  *
  *  @return Return the actual relative humidity output as u32
  *
 */
-u32 bme280_compensate_humidity_int32(s32 v_uncomp_humidity_s32);
+u32 bme280_compensate_humidity_int32(
+struct bme280_t *p_bme280, s32 v_uncomp_humidity_s32);
+/**************************************************************/
+/**\name	FUNCTION FOR BATCH COMPENSATION */
+/**************************************************************/
+/*!
+ * @brief Compensates arrays of uncompensated temperature,
+ * pressure and humidity with the 32 bit integer formulas.
+ * t_fine is carried from the temperature to the pressure and
+ * humidity of the same index, the device is not modified.
+ * The samples are processed in chunks of
+ * BME280_BATCH_CHUNK_SIZE with one plain loop per quantity,
+ * so every loop runs one inlined kernel over contiguous
+ * arrays. The loops are not vectorized, the pressure
+ * kernel divides and returns early on invalid data.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param a_uncomp_temperature_s32 : uncompensated temperatures
+ *  @param a_uncomp_pressure_s32 : uncompensated pressures
+ *  or BME280_NULL
+ *  @param a_uncomp_humidity_s32 : uncompensated humidities
+ *  or BME280_NULL
+ *  @param a_temperature_s32 : temperatures in 0.01 DegC
+ *  @param a_pressure_u32 : pressures in Pa, BME280_NULL if
+ *  a_uncomp_pressure_s32 is BME280_NULL
+ *  @param a_humidity_u32 : humidities in Q22.10 %rH, BME280_NULL
+ *  if a_uncomp_humidity_s32 is BME280_NULL
+ *  @param v_count_u32 : number of samples in every array
+ *
+ *	@return results of the parameter check
+ *	@retval 0 -> Success
+ *	@retval -127 -> Missing array
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_compensate_int32_batch(
+const struct bme280_t *p_bme280,
+const s32 *a_uncomp_temperature_s32,
+const s32 *a_uncomp_pressure_s32,
+const s32 *a_uncomp_humidity_s32,
+s32 *a_temperature_s32, u32 *a_pressure_u32,
+u32 *a_humidity_u32, u32 v_count_u32);
 /*!
  * @brief Reads actual humidity from uncompensated humidity
  * @note Returns the value in %rH as unsigned 16bit integer
@@ -1019,6 +1243,7 @@ u32 bme280_compensate_humidity_int32(s32 v_uncomp_humidity_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncomp_humidity_s32: value of uncompensated humidity
  *
  *
@@ -1026,7 +1251,7 @@ u32 bme280_compensate_humidity_int32(s32 v_uncomp_humidity_s32);
  *
 */
 u16 bme280_compensate_humidity_int32_sixteen_bit_output(
-s32 v_uncomp_humidity_s32);
+struct bme280_t *p_bme280, s32 v_uncomp_humidity_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR  INTIALIZATION UNCOMPENSATED PRESSURE,
  TEMPERATURE AND HUMIDITY */
@@ -1038,6 +1263,7 @@ s32 v_uncomp_humidity_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_uncomp_pressure_s32: The value of uncompensated pressure.
  *  @param  v_uncomp_temperature_s32: The value of uncompensated temperature
  *  @param  v_uncomp_humidity_s32: The value of uncompensated humidity.
@@ -1051,7 +1277,7 @@ s32 v_uncomp_humidity_s32);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_uncomp_pressure_temperature_humidity(
-s32 *v_uncomp_pressure_s32,
+struct bme280_t *p_bme280, s32 *v_uncomp_pressure_s32,
 s32 *v_uncomp_temperature_s32, s32 *v_uncomp_humidity_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR TRUE UNCOMPENSATED PRESSURE,
@@ -1063,6 +1289,7 @@ s32 *v_uncomp_temperature_s32, s32 *v_uncomp_humidity_s32);
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param  v_pressure_u32 : The value of compensated pressure.
  *	@param  v_temperature_s32 : The value of compensated temperature.
  *	@param  v_humidity_u32 : The value of compensated humidity.
@@ -1075,6 +1302,7 @@ s32 *v_uncomp_temperature_s32, s32 *v_uncomp_humidity_s32);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_read_pressure_temperature_humidity(
+struct bme280_t *p_bme280,
 u32 *v_pressure_u32, s32 *v_temperature_s32, u32 *v_humidity_u32);
 /**************************************************************/
 /**\name	FUNCTION FOR CALIBRATION */
@@ -1101,13 +1329,38 @@ u32 *v_pressure_u32, s32 *v_temperature_s32, u32 *v_humidity_u32);
  *	dig_H2    |  0xE1 and 0xE2   | from 0 : 7 to 8: 15
  *	dig_H3    |         0xE3     | from 0 to 7
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(struct bme280_t *p_bme280);
+/*!
+ *	@brief This function initializes the device like bme280_init()
+ *	but takes the calibration parameters from a cache.
+ *	Only dig_T1 to dig_T3 are read back and compared with the
+ *	cache. When they match, the cached parameters are used and
+ *	the full calibration read is skipped. Otherwise the
+ *	calibration is read from the sensor.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *	@param p_calib_param : cached calibration parameters or
+ *	BME280_NULL when the cache is empty
+ *	@param v_cache_hit_u8 : BME280_CALIB_CACHE_HIT when the cached
+ *	parameters were used, BME280_CALIB_CACHE_MISS when the
+ *	calibration was read from the sensor
+ *
  *	@return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void);
+BME280_RETURN_FUNCTION_TYPE bme280_init_cached(struct bme280_t *p_bme280,
+const struct bme280_calibration_param_t *p_calib_param, u8 *v_cache_hit_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR TEMPERATURE OVER SAMPLING */
 /**************************************************************/
@@ -1126,6 +1379,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void);
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of temperature over sampling
  *
  *
@@ -1137,7 +1391,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_calib_param(void);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_temperature(
-u8 *v_value_u8);
+struct bme280_t *p_bme280, u8 *v_value_u8);
 /*!
  *	@brief This API is used to set
  *	the temperature oversampling setting in the register 0xF4
@@ -1153,6 +1407,7 @@ u8 *v_value_u8);
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of temperature over sampling
  *
  *
@@ -1164,7 +1419,7 @@ u8 *v_value_u8);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_set_oversamp_temperature(
-u8 v_value_u8);
+struct bme280_t *p_bme280, u8 v_value_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR PRESSURE OVER SAMPLING */
 /**************************************************************/
@@ -1183,6 +1438,7 @@ u8 v_value_u8);
  *	0x05,0x06 and 0x07 | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of pressure oversampling
  *
  *
@@ -1194,7 +1450,7 @@ u8 v_value_u8);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_pressure(
-u8 *v_value_u8);
+struct bme280_t *p_bme280, u8 *v_value_u8);
 /*!
  *	@brief This API is used to set
  *	the pressure oversampling setting in the register 0xF4
@@ -1210,6 +1466,7 @@ u8 *v_value_u8);
  *	0x05,0x06 and 0x07 | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_value_u8 : The value of pressure oversampling
  *
  *
@@ -1221,7 +1478,7 @@ u8 *v_value_u8);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_set_oversamp_pressure(
-u8 v_value_u8);
+struct bme280_t *p_bme280, u8 v_value_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR HUMIDITY OVER SAMPLING */
 /**************************************************************/
@@ -1240,6 +1497,7 @@ u8 v_value_u8);
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_value_u8 : The value of humidity over sampling
  *
  *
@@ -1250,7 +1508,8 @@ u8 v_value_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_humidity(u8 *v_value_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_humidity(
+struct bme280_t *p_bme280, u8 *v_value_u8);
 /*!
  *	@brief This API is used to set
  *	the humidity oversampling setting in the register 0xF2
@@ -1266,6 +1525,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_humidity(u8 *v_value_u8);
  *	0x05,0x06 and 0x07  | BME280_OVERSAMP_16X
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_value_u8 : The value of humidity over sampling
  *
  *
@@ -1291,7 +1551,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_oversamp_humidity(u8 *v_value_u8);
  *
 */
 BME280_RETURN_FUNCTION_TYPE bme280_set_oversamp_humidity(
-u8 v_value_u8);
+struct bme280_t *p_bme280, u8 v_value_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR POWER MODE*/
 /**************************************************************/
@@ -1301,6 +1561,7 @@ u8 v_value_u8);
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_power_mode_u8 : The value of power mode
  *  value           |    mode
  * -----------------|------------------
@@ -1314,13 +1575,15 @@ u8 v_value_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(u8 *v_power_mode_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(
+struct bme280_t *p_bme280, u8 *v_power_mode_u8);
 /*!
  *	@brief This API used to set the
  *	Operational Mode from the sensor in the register 0xF4 bit 0 and 1
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_power_mode_u8 : The value of power mode
  *  value           |    mode
  * -----------------|------------------
@@ -1334,7 +1597,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_power_mode(u8 *v_power_mode_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(
+struct bme280_t *p_bme280, u8 v_power_mode_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR SOFT RESET*/
 /**************************************************************/
@@ -1343,9 +1607,11 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8);
  * The value 0xB6 is written to the 0xE0
  * register the device is reset using the
  * complete power-on-reset procedure.
- * @note Soft reset can be easily set using bme280_set_softreset().
- * @note Usage Hint : bme280_set_softreset()
+ * @note Soft reset can be easily set using bme280_set_soft_rst(p_bme280).
+ * @note Usage Hint : bme280_set_soft_rst(p_bme280)
+ *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *
  *	@return results of bus communication function
  *	@retval 0 -> Success
@@ -1353,7 +1619,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_power_mode(u8 v_power_mode_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(void);
+BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(struct bme280_t *p_bme280);
 /**************************************************************/
 /**\name	FUNCTION FOR SPI ENABLE*/
 /**************************************************************/
@@ -1363,6 +1629,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(void);
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_enable_disable_u8 : The value of SPI enable
  *	value  | Description
  * --------|--------------
@@ -1377,13 +1644,15 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_soft_rst(void);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(u8 *v_enable_disable_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(
+struct bme280_t *p_bme280, u8 *v_enable_disable_u8);
 /*!
  *	@brief This API used to set the sensor
  *	SPI mode(communication type) in the register 0xF5 bit 0
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_enable_disable_u8 : The value of SPI enable
  *	value  | Description
  * --------|--------------
@@ -1398,7 +1667,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_spi3(u8 *v_enable_disable_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(
+struct bme280_t *p_bme280, u8 v_enable_disable_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR IIR FILTER*/
 /**************************************************************/
@@ -1408,6 +1678,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8);
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_value_u8 : The value of IIR filter coefficient
  *
  *	value	    |	Filter coefficient
@@ -1424,13 +1695,15 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_spi3(u8 v_enable_disable_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_filter(u8 *v_value_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_get_filter(
+struct bme280_t *p_bme280, u8 *v_value_u8);
 /*!
  *	@brief This API is used to write filter setting
  *	in the register 0xF5 bit 3 and 4
  *
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_value_u8 : The value of IIR filter coefficient
  *
  *	value	    |	Filter coefficient
@@ -1447,7 +1720,8 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_filter(u8 *v_value_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_set_filter(
+struct bme280_t *p_bme280, u8 v_value_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR STANDBY DURATION*/
 /**************************************************************/
@@ -1455,6 +1729,7 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8);
  *	@brief This API used to Read the
  *	standby duration time from the sensor in the register 0xF5 bit 5 to 7
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_standby_durn_u8 : The value of standby duration time value.
  *  value       | standby duration
  * -------------|-----------------------
@@ -1474,11 +1749,13 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_filter(u8 v_value_u8);
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(u8 *v_standby_durn_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(
+struct bme280_t *p_bme280, u8 *v_standby_durn_u8);
 /*!
  *	@brief This API used to write the
  *	standby duration time from the sensor in the register 0xF5 bit 5 to 7
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_standby_durn_u8 : The value of standby duration time value.
  *  value       | standby duration
  * -------------|-----------------------
@@ -1498,17 +1775,48 @@ BME280_RETURN_FUNCTION_TYPE bme280_get_standby_durn(u8 *v_standby_durn_u8);
  *	the contents of the register t_sb.
  *	Standby time can be set using BME280_STANDBY_TIME_125_MS.
  *
- *	@note Usage Hint : bme280_set_standby_durn(BME280_STANDBY_TIME_125_MS)
+ *	@note Usage Hint : bme280_set_standby_durn(p_bme280,
+ *	BME280_STANDBY_TIME_125_MS)
+ *
  *
  *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(
+struct bme280_t *p_bme280, u8 v_standby_durn_u8);
+/**************************************************************/
+/**\name	FUNCTION FOR COMPLETE CONFIGURATION*/
+/**************************************************************/
+/*!
+ *	@brief This API writes the oversampling, standby, filter
+ *	and power mode settings in one burst write of register and
+ *	value pairs: 0xF4 (sleep), 0xF2, 0xF5 and 0xF4.
+ *	Entering sleep first makes the configuration register
+ *	writable and the last write latches the humidity setting,
+ *	so no soft reset is needed whatever the previous mode was.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *	@param p_config : settings to apply
+ *	@param v_verify_u8 : BME280_CONFIG_VERIFY_ENABLE to read the
+ *	registers back and compare them with the written values
+ *
+ *	@note Usage Hint : bme280_apply_config(p_bme280, &config,
+ *	BME280_CONFIG_VERIFY_DISABLE)
  *
  *	@return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
+ *	@retval -3 -> Read back registers differ
  *
  *
 */
-BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8);
+BME280_RETURN_FUNCTION_TYPE bme280_apply_config(
+struct bme280_t *p_bme280, const struct bme280_config_t *p_config,
+u8 v_verify_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR WORK MODE*/
 /**************************************************************/
@@ -1537,11 +1845,37 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR FORCE MODE DATA READ*/
 /**************************************************************/
+/*!
+ * @brief This API starts one forced mode conversion with a
+ * single write of the register 0xF4. A sensor in normal mode
+ * is put to sleep in the same burst, the other control
+ * registers are left as they are.
+ * The cached power mode is set to sleep, where the sensor
+ * returns by itself once the conversion is done.
+ *
+ *	@param p_bme280 : pointer to the bme280 device structure
+ *
+ *	@note Usage Hint : bme280_trigger_forced_measurement(p_bme280)
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BME280_RETURN_FUNCTION_TYPE bme280_trigger_forced_measurement(
+struct bme280_t *p_bme280);
 /*!
  * @brief This API used to read uncompensated
  * temperature,pressure and humidity in forced mode
  *
+ * The conversion is triggered with
+ * bme280_trigger_forced_measurement(), the typical
+ * conversion time is waited, bme280_wait_ready()
+ * polls until the data is valid and the data frame
+ * is burst read.
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_uncom_pressure_s32: The value of uncompensated pressure
  *	@param v_uncom_temperature_s32: The value of uncompensated temperature
  *	@param v_uncom_humidity_s32: The value of uncompensated humidity
@@ -1550,12 +1884,13 @@ BME280_RETURN_FUNCTION_TYPE bme280_set_standby_durn(u8 v_standby_durn_u8);
  *	@return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
+ *	@retval -4 -> Conversion not finished in time
  *
  *
 */
 BME280_RETURN_FUNCTION_TYPE
 bme280_get_forced_uncomp_pressure_temperature_humidity(
-s32 *v_uncom_pressure_s32,
+struct bme280_t *p_bme280, s32 *v_uncom_pressure_s32,
 s32 *v_uncom_temperature_s32, s32 *v_uncom_humidity_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR COMMON READ AND WRITE */
@@ -1566,6 +1901,7 @@ s32 *v_uncom_temperature_s32, s32 *v_uncom_humidity_s32);
  *	the given register
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_addr_u8 -> Address of the register
  *	@param v_data_u8 -> The data from the register
  *	@param v_len_u8 -> no of bytes to read
@@ -1577,7 +1913,8 @@ s32 *v_uncom_temperature_s32, s32 *v_uncom_humidity_s32);
  *
  *
  */
-BME280_RETURN_FUNCTION_TYPE bme280_write_register(u8 v_addr_u8,
+BME280_RETURN_FUNCTION_TYPE bme280_write_register(
+struct bme280_t *p_bme280, u8 v_addr_u8,
 u8 *v_data_u8, u8 v_len_u8);
 /*!
  * @brief
@@ -1585,6 +1922,7 @@ u8 *v_data_u8, u8 v_len_u8);
  *	the given register
  *
  *
+ *	@param p_bme280 : pointer to the bme280 device structure
  *	@param v_addr_u8 -> Address of the register
  *	@param v_data_u8 -> The data from the register
  *	@param v_len_u8 -> no of bytes to read
@@ -1596,7 +1934,8 @@ u8 *v_data_u8, u8 v_len_u8);
  *
  *
  */
-BME280_RETURN_FUNCTION_TYPE bme280_read_register(u8 v_addr_u8,
+BME280_RETURN_FUNCTION_TYPE bme280_read_register(
+struct bme280_t *p_bme280, u8 v_addr_u8,
 u8 *v_data_u8, u8 v_len_u8);
 /**************************************************************/
 /**\name	FUNCTION FOR FLOAT OUTPUT TEMPERATURE*/
@@ -1609,6 +1948,7 @@ u8 *v_data_u8, u8 v_len_u8);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_temperature_s32 : value of uncompensated temperature
  *
  *
@@ -1617,7 +1957,7 @@ u8 *v_data_u8, u8 v_len_u8);
  *
 */
 double bme280_compensate_temperature_double(
-s32 v_uncom_temperature_s32);
+struct bme280_t *p_bme280, s32 v_uncom_temperature_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR FLOAT OUTPUT PRESSURE*/
 /**************************************************************/
@@ -1628,13 +1968,15 @@ s32 v_uncom_temperature_s32);
  * equals 96386.2 Pa = 963.862 hPa.
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_pressure_s32 : value of uncompensated pressure
  *
  *
  *  @return  Return the actual pressure in floating point
  *
 */
-double bme280_compensate_pressure_double(s32 v_uncom_pressure_s32);
+double bme280_compensate_pressure_double(
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR FLOAT OUTPUT HUMIDITY*/
 /**************************************************************/
@@ -1643,6 +1985,7 @@ double bme280_compensate_pressure_double(s32 v_uncom_pressure_s32);
  * @note returns the value in relative humidity (%rH)
  * @note Output value of "42.12" equals 42.12 %rH
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_humidity_s32 : value of uncompensated humidity
  *
  *
@@ -1650,7 +1993,55 @@ double bme280_compensate_pressure_double(s32 v_uncom_pressure_s32);
  *  @return Return the actual humidity in floating point
  *
 */
-double bme280_compensate_humidity_double(s32 v_uncom_humidity_s32);
+double bme280_compensate_humidity_double(
+struct bme280_t *p_bme280, s32 v_uncom_humidity_s32);
+/**************************************************************/
+/**\name	FUNCTION FOR SINGLE PRECISION OUTPUT*/
+/**************************************************************/
+/*!
+ * @brief Reads actual temperature from uncompensated temperature
+ * in single precision, for FPUs without double support
+ * @note returns the value in Degree centigrade
+ * @note The difference to the double output is far below
+ * the resolution of the sensor.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *
+ *
+ *  @return  Return the actual temperature in floating point
+ *
+*/
+float bme280_compensate_temperature_float(
+struct bme280_t *p_bme280, s32 v_uncom_temperature_s32);
+/*!
+ * @brief Reads actual pressure from uncompensated pressure
+ * in single precision, for FPUs without double support
+ * @note Returns pressure in Pa as float.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *
+ *
+ *  @return  Return the actual pressure in floating point
+ *
+*/
+float bme280_compensate_pressure_float(
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32);
+/*!
+ * @brief Reads actual humidity from uncompensated humidity
+ * in single precision, for FPUs without double support
+ * @note returns the value in relative humidity (%rH)
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *
+ *  @return Return the actual humidity in floating point
+ *
+*/
+float bme280_compensate_humidity_float(
+struct bme280_t *p_bme280, s32 v_uncom_humidity_s32);
 #endif
 /**************************************************************/
 /**\name	FUNCTION FOR 64BIT OUTPUT PRESSURE*/
@@ -1666,13 +2057,15 @@ double bme280_compensate_humidity_double(s32 v_uncom_humidity_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param  v_uncom_pressure_s32 : value of uncompensated temperature
  *
  *
  *  @return Return the actual pressure in u32
  *
 */
-u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32);
+u32 bme280_compensate_pressure_int64(
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR 24BIT OUTPUT PRESSURE*/
 /**************************************************************/
@@ -1684,6 +2077,7 @@ u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_uncom_pressure_s32 : value of uncompensated pressure
  *
  *
@@ -1691,7 +2085,7 @@ u32 bme280_compensate_pressure_int64(s32 v_uncom_pressure_s32);
  *
 */
 u32 bme280_compensate_pressure_int64_twentyfour_bit_output(
-s32 v_uncom_pressure_s32);
+struct bme280_t *p_bme280, s32 v_uncom_pressure_s32);
 #endif
 /**************************************************************/
 /**\name	FUNCTION FOR WAIT PERIOD*/
@@ -1702,6 +2096,7 @@ s32 v_uncom_pressure_s32);
  *
  *
  *
+ *  @param p_bme280 : pointer to the bme280 device structure
  *  @param v_delaytime_u8 : The value of delay time for force mode
  *
  *
@@ -1709,6 +2104,165 @@ s32 v_uncom_pressure_s32);
  *
  *
  */
-BME280_RETURN_FUNCTION_TYPE bme280_compute_wait_time(u8
+BME280_RETURN_FUNCTION_TYPE bme280_compute_wait_time(
+struct bme280_t *p_bme280, u8
 *v_delaytime_u8);
+/*!
+ * @brief Computing the maximum conversion time of one
+ * forced measurement in microseconds from the datasheet
+ * formula, without rounding up to whole milliseconds
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_time_u32 : The conversion time in microseconds
+ *
+ *
+ *	@retval 0 -> Success
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_compute_measurement_time_usec(
+struct bme280_t *p_bme280, u32 *v_time_u32);
+/*!
+ * @brief Computing the typical conversion time of one
+ * forced measurement in microseconds. A conversion is
+ * not expected to be done earlier, so it is the time
+ * to sleep before polling with bme280_wait_ready()
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_time_u32 : The conversion time in microseconds
+ *
+ *
+ *	@retval 0 -> Success
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_compute_typical_measurement_time_usec(
+struct bme280_t *p_bme280, u32 *v_time_u32);
+/*!
+ * @brief Computing the period of the data output in
+ * normal mode in microseconds: the typical conversion
+ * time of the oversampling settings plus the standby
+ * time of the config register. The oscillator of the
+ * sensor may be off by a few percent, so a reader
+ * polling at this period now and then sees the same
+ * conversion twice or misses one.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_period_u32 : The output period in microseconds
+ *
+ *
+ *	@retval 0 -> Success
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_compute_normal_mode_period_usec(
+struct bme280_t *p_bme280, u32 *v_period_u32);
+/*!
+ * @brief Polls the status register 0xF3 until neither
+ * measuring (bit 3) nor im_update (bit 0) is set.
+ * Between two reads BME280_STATUS_POLL_INTERVAL_USEC is
+ * waited with bme280_wait_usec(). The timeout counts the
+ * time elapsed on the now_usec clock, or the nominal
+ * poll intervals when the device has no clock.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_timeout_usec_u32 : The longest time to poll
+ *
+ *	@note Usage Hint : bme280_wait_ready(p_bme280,
+ *	BME280_WAIT_READY_MARGIN_USEC)
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -4 -> Still busy after the timeout
+ *
+ *
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_wait_ready(
+struct bme280_t *p_bme280, u32 v_timeout_usec_u32);
+/*!
+ * @brief Waits the given time with delay_usec, or with
+ * delay_msec rounded up to whole milliseconds when the
+ * microsecond delay is not provided
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_time_u32 : The time to wait in microseconds
+ *
+ *
+ */
+void bme280_wait_usec(struct bme280_t *p_bme280, u32 v_time_u32);
+/**************************************************************/
+/**\name	FUNCTION FOR FUSED COMPENSATION */
+/**************************************************************/
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity with the 32 bit integer formulas.
+ * t_fine is passed between the formulas internally, the
+ * device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in 0.01 DegC, pressure in Pa and
+ *  humidity in Q22.10 %rH
+ *
+*/
+struct bme280_compensated_int32_t bme280_compensate_all_int32(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32);
+#if defined(BME280_ENABLE_INT64) && defined(BME280_64BITSUPPORT_PRESENT)
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity, the pressure with the 64 bit
+ * integer formula. The device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in 0.01 DegC, pressure in Q24.8 Pa and
+ *  humidity in Q22.10 %rH
+ *
+*/
+struct bme280_compensated_int64_t bme280_compensate_all_int64(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32);
+#endif
+#ifdef BME280_ENABLE_FLOAT
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity in double precision.
+ * The device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in DegC, pressure in Pa and humidity in %rH
+ *
+*/
+struct bme280_compensated_double_t bme280_compensate_all_double(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32);
+/*!
+ * @brief Compensates one set of uncompensated pressure,
+ * temperature and humidity in single precision.
+ * The device is not modified.
+ *
+ *  @param p_bme280 : pointer to the bme280 device structure
+ *  @param v_uncom_pressure_s32 : value of uncompensated pressure
+ *  @param v_uncom_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncom_humidity_s32 : value of uncompensated humidity
+ *
+ *  @return temperature in DegC, pressure in Pa and humidity in %rH
+ *
+*/
+struct bme280_compensated_float_t bme280_compensate_all_float(
+const struct bme280_t *p_bme280, s32 v_uncom_pressure_s32,
+s32 v_uncom_temperature_s32, s32 v_uncom_humidity_s32);
+#endif
 #endif
@@ -0,0 +1,122 @@
+/*
+ * File:   bme280_sampler.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Batched sampling of several BME280 sensors sharing one bus: every
+ * sensor is triggered first, the typical time of the longest conversion
+ * is slept once with the delay functions of the slowest sensor, and each
+ * data frame is read as soon as the status of its sensor reports it valid.
+ */
+
+#ifndef BME280_SAMPLER_H
+#define BME280_SAMPLER_H
+
+#include "bme280.h"
+
+#define BME280_SAMPLER_MAX_SENSORS (8)
+/* conversions after which the anchor of the period bounds moves up,
+the bounds must not span half the range of the u32 clock */
+#define BME280_SAMPLER_ANCHOR_CONVERSIONS (1024)
+
+/*!
+ * @brief Optional bus routing hook called before every access to a
+ * sensor, e.g. to switch an I2C multiplexer channel for sensors that
+ * share the same address.
+ */
+typedef BME280_RETURN_FUNCTION_TYPE (*bme280_sampler_select_t)(
+void *context, u8 v_dev_addr_u8);
+
+/*!
+ * @brief Timing of a sensor in normal mode on its now_usec clock.
+ * The end of the last conversion and the output period are kept as
+ * bounds; the period bounds come from the conversions counted since
+ * an anchor conversion, so they tighten with every conversion.
+ */
+struct bme280_sampler_timing_t {
+	u32 read_start_usec;/**< clock before the last read*/
+	u32 end_min_usec;/**< the last conversion ended after this*/
+	u32 end_max_usec;/**< the last conversion ended at or before*/
+	u32 period_min_usec;/**< lower bound on the output period*/
+	u32 period_max_usec;/**< upper bound on the output period*/
+	u32 anchor_min_usec;/**< bounds on the end of the anchor*/
+	u32 anchor_max_usec;
+	u16 conversions;/**< conversions since the anchor*/
+	u8 is_valid;/**< the bounds hold, cleared on a contradiction*/
+};
+
+/*!
+ * @brief One sensor slot of the sampler and the result of its last cycle
+ */
+struct bme280_sampler_sensor_t {
+	struct bme280_t *device;/**< initialized driver instance*/
+	bme280_sampler_select_t select;/**< bus routing hook or NULL*/
+	void *select_context;/**< context passed to the routing hook*/
+
+	s32 uncomp_pressure;/**< last uncompensated pressure*/
+	s32 uncomp_temperature;/**< last uncompensated temperature*/
+	s32 uncomp_humidity;/**< last uncompensated humidity*/
+	BME280_RETURN_FUNCTION_TYPE result;/**< bus result of last cycle*/
+	u8 is_repeated;
+	/**< normal mode: the sensor ended no conversion since the read
+	before, the frame is the one read then*/
+	struct bme280_sampler_timing_t timing;/**< normal mode only*/
+};
+
+/*!
+ * @brief Sensors scheduled together in one sampling pass
+ */
+struct bme280_sampler_t {
+	struct bme280_sampler_sensor_t sensors[BME280_SAMPLER_MAX_SENSORS];
+	u8 sensor_count;/**< number of used slots*/
+};
+
+/*!
+ *	@brief Adds an initialized sensor to the sampler
+ *
+ *	@param sampler : sampler to extend
+ *	@param device : sensor initialized with bme280_init()
+ *	@param select : bus routing hook, BME280_NULL if not multiplexed
+ *	@param select_context : context passed to the routing hook
+ *	@param v_index_u8 : slot index of the sensor, BME280_NULL if unused
+ *
+ *	@return results of the call
+ *	@retval 0 -> Success
+ *	@retval E_BME280_OUT_OF_RANGE -> All slots are used
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_sampler_add(
+struct bme280_sampler_t *sampler, struct bme280_t *device,
+bme280_sampler_select_t select, void *select_context, u8 *v_index_u8);
+
+/*!
+ *	@brief Runs one sampling pass over all sensors
+ *
+ *	Sensors that are not in normal mode are put into forced mode one
+ *	after another with a single register write each, the typical
+ *	time of the longest conversion is waited once, then every
+ *	sensor is polled with bme280_wait_ready() and its data frame
+ *	is burst read. The raw values and the bus
+ *	result of every sensor are stored in its slot.
+ *	Sensors in normal mode are read as they are. Two
+ *	conversions may give equal raw values, at x1 and with
+ *	humidity skipped they often do, so a frame that equals
+ *	the one read before is flagged is_repeated only if the
+ *	timing of the sensor says no conversion ended since:
+ *	frames that differ bound the end of their conversion
+ *	between two reads, and the output period learnt from
+ *	them predicts the next end. An equal frame read while
+ *	that end may just have passed is read again once it
+ *	surely has, after half an output period at most; one
+ *	that still cannot be told apart, only while the bounds
+ *	are wide after the start, is taken as repeated. Without
+ *	a now_usec clock no frame is flagged.
+ *
+ *	@param sampler : sampler to run
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success for every sensor
+ *	@retval -1 -> Error on at least one sensor
+ */
+BME280_RETURN_FUNCTION_TYPE bme280_sampler_run(
+struct bme280_sampler_t *sampler);
+
+#endif /* BME280_SAMPLER_H */
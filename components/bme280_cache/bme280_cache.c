@@ -0,0 +1,153 @@
+/*
+ * File:   bme280_cache.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * BME280 calibration cache in NVS.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "esp_log.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "rom/crc.h"
+
+#include "bme280_cache.h"
+
+static const char *debug_tag = "BME280_CACHE";
+static const char *nvs_namespace = "bme280_cache";
+
+static nvs_handle handle;
+static uint8_t is_nvs_inited = 0;
+
+typedef struct {
+    uint8_t version;
+    uint8_t chip_id;
+    uint8_t device_address;
+    struct bme280_calibration_param_t calibration;
+    uint32_t crc;
+} bme280_cache_entry_t;
+
+static void bme280_cache_key(char key[16], uint8_t device_address) {
+    snprintf(key, 16, "cal_%02x_%02x", BME280_CHIP_ID, device_address);
+}
+
+static uint32_t bme280_cache_crc(const bme280_cache_entry_t *entry) {
+    return crc32_le(0, (const uint8_t *)entry, offsetof(bme280_cache_entry_t, crc));
+}
+
+static esp_err_t bme280_cache_load(uint8_t device_address, bme280_cache_entry_t *entry) {
+    char key[16];
+    size_t length = sizeof(*entry);
+    esp_err_t error;
+
+    bme280_cache_key(key, device_address);
+    error = nvs_get_blob(handle, key, entry, &length);
+    if (error != ESP_OK) {
+        return error;
+    }
+    if ((length != sizeof(*entry)) || (entry->version != BME280_CACHE_VERSION) ||
+        (entry->chip_id != BME280_CHIP_ID) || (entry->device_address != device_address)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (entry->crc != bme280_cache_crc(entry)) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t bme280_cache_store(const struct bme280_t *bme280) {
+    bme280_cache_entry_t entry;
+    char key[16];
+    esp_err_t error;
+
+    //padding is part of the CRC
+    memset(&entry, 0, sizeof(entry));
+    entry.version = BME280_CACHE_VERSION;
+    entry.chip_id = bme280->chip_id;
+    entry.device_address = bme280->dev_addr;
+    entry.calibration = bme280->cal_param;
+    entry.calibration.t_fine = 0;
+    entry.crc = bme280_cache_crc(&entry);
+
+    bme280_cache_key(key, bme280->dev_addr);
+    error = nvs_set_blob(handle, key, &entry, sizeof(entry));
+    if (error != ESP_OK) {
+        return error;
+    }
+
+    return nvs_commit(handle);
+}
+
+esp_err_t bme280_cache_open(void) {
+    //the partition may already be up for the wifi settings, a second init is harmless
+    esp_err_t error = nvs_flash_init();
+    if (error != ESP_OK) {
+        ESP_LOGW(debug_tag, "Failed to init NVS: %d", error);
+        return error;
+    }
+
+    error = nvs_open(nvs_namespace, NVS_READWRITE, &handle);
+    if (error != ESP_OK) {
+        ESP_LOGW(debug_tag, "Failed to open NVS: %d", error);
+        return error;
+    }
+
+    is_nvs_inited = 1;
+
+    return ESP_OK;
+}
+
+esp_err_t bme280_cache_close(void) {
+    if (is_nvs_inited > 0) {
+        nvs_close(handle);
+        is_nvs_inited = 0;
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_STATE;
+}
+
+int32_t bme280_cache_init(struct bme280_t *bme280) {
+    bme280_cache_entry_t entry;
+    esp_err_t error = ESP_ERR_INVALID_STATE;
+    int32_t result;
+    u8 cache_hit = BME280_CALIB_CACHE_MISS;
+
+    if (is_nvs_inited > 0) {
+        error = bme280_cache_load(bme280->dev_addr, &entry);
+        if ((error != ESP_OK) && (error != ESP_ERR_NVS_NOT_FOUND)) {
+            ESP_LOGW(debug_tag, "Calibration of 0x%02x dropped: %d", bme280->dev_addr, error);
+        }
+    }
+
+    result = bme280_init_cached(bme280, (error == ESP_OK) ? &entry.calibration : NULL, &cache_hit);
+    if ((result != SUCCESS) || (cache_hit == BME280_CALIB_CACHE_HIT) || (is_nvs_inited == 0)) {
+        return result;
+    }
+
+    error = bme280_cache_store(bme280);
+    if (error != ESP_OK) {
+        ESP_LOGW(debug_tag, "Calibration of 0x%02x was not saved, NVS: %d", bme280->dev_addr, error);
+    }
+
+    return result;
+}
+
+esp_err_t bme280_cache_erase(uint8_t device_address) {
+    char key[16];
+    esp_err_t error;
+
+    if (is_nvs_inited == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    bme280_cache_key(key, device_address);
+    error = nvs_erase_key(handle, key);
+    if ((error != ESP_OK) && (error != ESP_ERR_NVS_NOT_FOUND)) {
+        return error;
+    }
+
+    return nvs_commit(handle);
+}
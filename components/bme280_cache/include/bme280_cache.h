@@ -0,0 +1,26 @@
+/*
+ * File:   bme280_cache.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * BME280 calibration cache in NVS. The parsed calibration of every
+ * sensor is stored under its chip id and address with a CRC32, so a
+ * boot only reads the chip id and a short probe of the calibration
+ * words instead of the whole calibration.
+ */
+
+#ifndef BME280_CACHE_H
+#define BME280_CACHE_H
+
+#include "esp_err.h"
+
+#include "bme280.h"
+
+#define BME280_CACHE_VERSION 1
+
+esp_err_t bme280_cache_open(void);
+esp_err_t bme280_cache_close(void);
+//bme280_init() through the cache, returns the result of the driver
+int32_t bme280_cache_init(struct bme280_t *bme280);
+esp_err_t bme280_cache_erase(uint8_t device_address);
+
+#endif /* BME280_CACHE_H */
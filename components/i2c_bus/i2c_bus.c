@@ -0,0 +1,272 @@
+/*
+ * File:   i2c_bus.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Queued I2C master transport.
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+#include "i2c_bus.h"
+
+static const char *debug_tag = "I2C_BUS";
+
+#define I2C_BUS_FRAME_MAX_DATA_LENGTH 32
+
+static QueueHandle_t i2c_bus_queue = NULL;
+static i2c_port_t i2c_bus_port;
+static uint8_t i2c_bus_frame[I2C_BUS_FRAME_MAX_DATA_LENGTH+2];
+
+typedef struct {
+    SemaphoreHandle_t done;
+    esp_err_t error;
+} i2c_bus_waiter_t;
+
+typedef struct {
+    SemaphoreHandle_t done;
+    const i2c_config_t *config;
+    esp_err_t error;
+} i2c_bus_startup_t;
+
+//one wakeup semaphore per task that waits on the bus, so the task notifications
+//stay free for the tasks themselves. Slots are never given back, a slot of a
+//deleted task is only reused by a task that gets the same handle
+typedef struct {
+    TaskHandle_t task;
+    SemaphoreHandle_t done;
+} i2c_bus_client_t;
+
+static i2c_bus_client_t i2c_bus_clients[I2C_BUS_MAX_CLIENTS];
+static SemaphoreHandle_t i2c_bus_clients_lock = NULL;
+
+static esp_err_t i2c_bus_transfer(const i2c_bus_request_t *request) {
+    esp_err_t error;
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+
+    if (cmd == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    //the link and each of its command nodes are malloced, and the ISR consumes
+    //the link while it runs so it can't be replayed: keep the nodes few instead.
+    //Address and register (and payload, when it fits) go out as one write command
+    i2c_bus_frame[0] = (request->device_address << 1) | I2C_MASTER_WRITE;
+    i2c_bus_frame[1] = request->register_address;
+
+    i2c_master_start(cmd);
+    if (request->is_read) {
+        i2c_master_write(cmd, i2c_bus_frame, 2, true);
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (request->device_address << 1) | I2C_MASTER_READ, true);
+        if (request->length > 1) {
+            i2c_master_read(cmd, request->data, (request->length-1), 0);
+        }
+        i2c_master_read_byte(cmd, (request->data+(request->length-1)), 1);
+    }
+    else if (request->length <= I2C_BUS_FRAME_MAX_DATA_LENGTH) {
+        memcpy(&i2c_bus_frame[2], request->data, request->length);
+        i2c_master_write(cmd, i2c_bus_frame, (request->length+2), true);
+    }
+    else {
+        i2c_master_write(cmd, i2c_bus_frame, 2, true);
+        i2c_master_write(cmd, request->data, request->length, true);
+    }
+    i2c_master_stop(cmd);
+
+    error = i2c_master_cmd_begin(i2c_bus_port, cmd, (I2C_BUS_TIMEOUT_MS/portTICK_PERIOD_MS));
+    i2c_cmd_link_delete(cmd);
+
+    return error;
+}
+
+static SemaphoreHandle_t i2c_bus_client_semaphore(void) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    SemaphoreHandle_t done = NULL;
+    uint8_t i;
+
+    //only this task adds its own slot, the lock is needed for new slots only
+    for (i = 0; i < I2C_BUS_MAX_CLIENTS; i++) {
+        if (__atomic_load_n(&i2c_bus_clients[i].task, __ATOMIC_ACQUIRE) == task) {
+            return i2c_bus_clients[i].done;
+        }
+    }
+
+    xSemaphoreTake(i2c_bus_clients_lock, portMAX_DELAY);
+    for (i = 0; i < I2C_BUS_MAX_CLIENTS; i++) {
+        if (i2c_bus_clients[i].task == NULL) {
+            done = xSemaphoreCreateBinary();
+            if (done != NULL) {
+                i2c_bus_clients[i].done = done;
+                __atomic_store_n(&i2c_bus_clients[i].task, task, __ATOMIC_RELEASE);
+            }
+            break;
+        }
+    }
+    xSemaphoreGive(i2c_bus_clients_lock);
+
+    if (done == NULL) {
+        ESP_LOGW(debug_tag, "Failed to add I2C client, %d clients max", I2C_BUS_MAX_CLIENTS);
+    }
+    return done;
+}
+
+static void i2c_bus_task(void *context) {
+    i2c_bus_startup_t *startup = context;
+    SemaphoreHandle_t done = startup->done;
+    i2c_bus_request_t request;
+    esp_err_t error;
+
+    //the driver interrupt is allocated on the core that installs the driver,
+    //installing it here keeps it on the core of the bus task
+    error = i2c_driver_install(i2c_bus_port, startup->config->mode, 0, 0, 0);
+    startup->error = error;
+    xSemaphoreGive(done);
+    //startup lives on the stack of i2c_bus_init, it is gone from here on
+    if (error != ESP_OK) {
+        vTaskDelete(NULL);
+        return;
+    }
+
+    while(true) {
+        if (xQueueReceive(i2c_bus_queue, &request, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        error = i2c_bus_transfer(&request);
+        if (error != ESP_OK) {
+            ESP_LOGD(debug_tag, "Transfer to 0x%02x failed: %d", request.device_address, error);
+        }
+        if (request.callback) {
+            (*request.callback)(error, request.context);
+        }
+    }
+}
+
+static void i2c_bus_wakeup(esp_err_t error, void *context) {
+    i2c_bus_waiter_t *waiter = context;
+    //the waiter lives on the stack of the caller, it is gone once the semaphore is given
+    SemaphoreHandle_t done = waiter->done;
+
+    waiter->error = error;
+    xSemaphoreGive(done);
+}
+
+static esp_err_t i2c_bus_transfer_wait(i2c_bus_request_t *request) {
+    i2c_bus_waiter_t waiter = {
+        .done = i2c_bus_client_semaphore(),
+        .error = ESP_FAIL
+    };
+    esp_err_t error;
+
+    if (waiter.done == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    request->callback = i2c_bus_wakeup;
+    request->context = &waiter;
+
+    error = i2c_bus_submit(request, portMAX_DELAY);
+    if (error != ESP_OK) {
+        return error;
+    }
+    xSemaphoreTake(waiter.done, portMAX_DELAY);
+
+    return waiter.error;
+}
+
+esp_err_t i2c_bus_init(i2c_port_t port, const i2c_config_t *config, UBaseType_t priority, BaseType_t core_id) {
+    i2c_bus_startup_t startup = {
+        .config = config,
+        .error = ESP_FAIL
+    };
+    esp_err_t error;
+
+    if (i2c_bus_queue != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (i2c_bus_clients_lock == NULL) {
+        i2c_bus_clients_lock = xSemaphoreCreateMutex();
+        if (i2c_bus_clients_lock == NULL) {
+            ESP_LOGW(debug_tag, "Failed to create I2C client lock");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    startup.done = i2c_bus_client_semaphore();
+    if (startup.done == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    error = i2c_param_config(port, config);
+    if (error != ESP_OK) {
+        ESP_LOGW(debug_tag, "Failed to configure I2C: %d", error);
+        return error;
+    }
+
+    i2c_bus_port = port;
+    i2c_bus_queue = xQueueCreate(I2C_BUS_QUEUE_LENGTH, sizeof(i2c_bus_request_t));
+    if (i2c_bus_queue == NULL) {
+        ESP_LOGW(debug_tag, "Failed to create I2C request queue");
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreatePinnedToCore(&i2c_bus_task, "i2c_bus_task", I2C_BUS_TASK_STACK_SIZE, &startup, priority, NULL, core_id) != pdPASS) {
+        ESP_LOGW(debug_tag, "Failed to create I2C bus task");
+        error = ESP_ERR_NO_MEM;
+    }
+    else {
+        xSemaphoreTake(startup.done, portMAX_DELAY);
+        error = startup.error;
+        if (error != ESP_OK) {
+            ESP_LOGW(debug_tag, "Failed to install I2C driver: %d", error);
+        }
+    }
+    if (error != ESP_OK) {
+        vQueueDelete(i2c_bus_queue);
+        i2c_bus_queue = NULL;
+    }
+
+    return error;
+}
+
+esp_err_t i2c_bus_submit(const i2c_bus_request_t *request, TickType_t timeout) {
+    if (i2c_bus_queue == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if ((request->length == 0) || (request->data == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (xQueueSend(i2c_bus_queue, request, timeout) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    i2c_bus_request_t request = {
+        .device_address = device_address,
+        .register_address = register_address,
+        .data = data,
+        .length = length,
+        .is_read = 1
+    };
+
+    return i2c_bus_transfer_wait(&request);
+}
+
+esp_err_t i2c_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    i2c_bus_request_t request = {
+        .device_address = device_address,
+        .register_address = register_address,
+        .data = data,
+        .length = length,
+        .is_read = 0
+    };
+
+    return i2c_bus_transfer_wait(&request);
+}
@@ -0,0 +1,44 @@
+/*
+ * File:   i2c_bus.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Queued I2C master transport. A dedicated bus task owns the I2C
+ * peripheral, callers post register transfers and get a completion
+ * callback (i2c_bus_submit) or block on a semaphore of their own while
+ * the bytes move on the wire (i2c_bus_read, i2c_bus_write), their task
+ * notifications are left alone. The bus task and the driver interrupt
+ * run on the core given to i2c_bus_init.
+ *
+ * Every transfer mallocs a command link and its nodes through
+ * i2c_cmd_link_create(), the transport is not allocation free.
+ */
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include "driver/i2c.h"
+
+#define I2C_BUS_QUEUE_LENGTH 8
+#define I2C_BUS_TASK_STACK_SIZE 2048
+#define I2C_BUS_TIMEOUT_MS 10
+//tasks that block in i2c_bus_read and i2c_bus_write
+#define I2C_BUS_MAX_CLIENTS 4
+
+typedef void (*i2c_bus_cb_t)(esp_err_t error, void *context);
+
+typedef struct {
+    uint8_t device_address;
+    uint8_t register_address;
+    uint8_t *data;          //must stay valid until the callback runs
+    uint8_t length;
+    uint8_t is_read;
+    i2c_bus_cb_t callback;  //called from the bus task, may be NULL
+    void *context;
+} i2c_bus_request_t;
+
+esp_err_t i2c_bus_init(i2c_port_t port, const i2c_config_t *config, UBaseType_t priority, BaseType_t core_id);
+esp_err_t i2c_bus_submit(const i2c_bus_request_t *request, TickType_t timeout);
+esp_err_t i2c_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length);
+esp_err_t i2c_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length);
+
+#endif /* I2C_BUS_H */
@@ -0,0 +1,39 @@
+/*
+ * File:   telemetry.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Sample and window summary records shared by the sampling, buffering,
+ * aggregation and transmit stages.
+ * Values are the outputs of the int32 compensation. Timestamps count
+ * microseconds since boot in continuous mode and of the RTC clock in
+ * deep sleep mode.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+#include "telemetry_stats.h"
+
+typedef struct {
+    uint64_t timestamp_usec;    //node clock when the sampling pass started
+    uint32_t sequence;          //counts every sample of the node
+    int32_t temperature;        //0.01 DegC
+    uint32_t pressure;          //Pa
+    uint32_t humidity;          //1/1024 %rH
+    uint8_t sensor;             //I2C address of the sensor
+} telemetry_sample_t;
+
+//samples of one sensor in one window, in the units of telemetry_sample_t
+typedef struct {
+    uint64_t start_usec;        //node clock where the window starts
+    uint32_t length_usec;
+    uint32_t sequence;          //counts every summary of the node
+    uint8_t sensor;
+    telemetry_stats_t temperature;
+    telemetry_stats_t pressure;
+    telemetry_stats_t humidity;
+} telemetry_summary_t;
+
+#endif /* TELEMETRY_H */
@@ -0,0 +1,60 @@
+/*
+ * File:   telemetry_aggregate.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Windowed aggregation of the sample stream. Windows are aligned to
+ * multiples of the window length on the node clock, so the windows of
+ * all sensors line up. Every sensor keeps count, min, max and the sums
+ * and squared sums of its channels over the open window, taken around
+ * the first value of the window in integers, so a sample costs no
+ * floating point. The first sample of a later window closes it, works
+ * out mean and variance and hands the summary to the emit callback.
+ * Samples older than the open window are counted and ignored.
+ */
+
+#ifndef TELEMETRY_AGGREGATE_H
+#define TELEMETRY_AGGREGATE_H
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+#define TELEMETRY_AGGREGATE_MAX_SENSORS 8
+
+typedef void (*telemetry_aggregate_emit_t)(void *context, const telemetry_summary_t *summary);
+
+typedef struct {
+    int32_t offset;             //first value of the window
+    int32_t min;
+    int32_t max;
+    int64_t sum;                //of the differences to the offset
+    uint64_t square_sum;
+} telemetry_aggregate_channel_t;
+
+typedef struct {
+    telemetry_summary_t summary;    //sensor and window, the stats are filled on close
+    uint32_t count;
+    telemetry_aggregate_channel_t temperature;
+    telemetry_aggregate_channel_t pressure;
+    telemetry_aggregate_channel_t humidity;
+} telemetry_aggregate_window_t;
+
+typedef struct {
+    uint32_t window_usec;
+    uint8_t sensor_count;
+    telemetry_aggregate_window_t windows[TELEMETRY_AGGREGATE_MAX_SENSORS];
+    telemetry_aggregate_emit_t emit;
+    void *context;
+
+    uint32_t sequence;
+    uint32_t late;              //samples older than the open window
+    uint32_t unknown;           //samples of sensors beyond the max
+} telemetry_aggregate_t;
+
+void telemetry_aggregate_init(telemetry_aggregate_t *aggregate, uint32_t window_usec,
+                              telemetry_aggregate_emit_t emit, void *context);
+void telemetry_aggregate_add(telemetry_aggregate_t *aggregate, const telemetry_sample_t *sample);
+//closes every open window, e.g. before the node stops
+void telemetry_aggregate_flush(telemetry_aggregate_t *aggregate);
+
+#endif /* TELEMETRY_AGGREGATE_H */
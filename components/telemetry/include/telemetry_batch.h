@@ -0,0 +1,58 @@
+/*
+ * File:   telemetry_batch.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Packs several samples into one datagram. The datagram is handed to the
+ * send callback when the sample count is reached, when it can't take
+ * another sample, when its oldest sample reaches the max age (checked by
+ * telemetry_batch_poll) or on telemetry_batch_flush. A datagram is either
+ * wire format records back to back or one delta coded series, the
+ * receiver tells them apart by the version byte and decodes until it
+ * runs out of bytes.
+ */
+
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry.h"
+#include "telemetry_delta.h"
+#include "telemetry_wire.h"
+
+//UDP payload of a 1500 byte MTU
+#define TELEMETRY_BATCH_MAX_LENGTH 1472
+#define TELEMETRY_BATCH_MAX_RECORDS (TELEMETRY_BATCH_MAX_LENGTH/TELEMETRY_WIRE_RECORD_SIZE)
+
+typedef enum {
+    TELEMETRY_BATCH_RECORDS,    //telemetry_wire.h records
+    TELEMETRY_BATCH_DELTA       //telemetry_delta.h series
+} telemetry_batch_format_t;
+
+typedef void (*telemetry_batch_send_t)(void *context, const uint8_t *data, size_t length);
+
+typedef struct {
+    uint8_t data[TELEMETRY_BATCH_MAX_LENGTH];
+    size_t length;
+    telemetry_batch_format_t format;
+    telemetry_delta_encoder_t delta;
+    uint16_t count;
+    uint16_t max_count;         //0 fills the datagram
+    uint64_t max_age_usec;      //0 disables the age limit
+    uint64_t oldest_usec;       //time the first pending sample was added
+    uint16_t node_id;
+    telemetry_batch_send_t send;
+    void *context;
+
+    uint32_t datagrams;
+    uint32_t samples;
+} telemetry_batch_t;
+
+void telemetry_batch_init(telemetry_batch_t *batch, uint16_t node_id, telemetry_batch_format_t format,
+                          uint16_t max_count, uint64_t max_age_usec, telemetry_batch_send_t send, void *context);
+void telemetry_batch_add(telemetry_batch_t *batch, const telemetry_sample_t *sample, uint64_t now_usec);
+void telemetry_batch_poll(telemetry_batch_t *batch, uint64_t now_usec);
+void telemetry_batch_flush(telemetry_batch_t *batch);
+
+#endif /* TELEMETRY_BATCH_H */
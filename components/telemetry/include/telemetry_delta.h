@@ -0,0 +1,84 @@
+/*
+ * File:   telemetry_delta.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Delta coded series of telemetry samples, wire version 2. A series
+ * fills a whole datagram and starts with a 3 byte header:
+ *
+ *   offset  size  field
+ *        0     1  version, TELEMETRY_DELTA_VERSION
+ *        1     2  node id, little endian
+ *
+ * The samples follow up to the end of the datagram, each one is the
+ * sensor address byte and five zig-zag varints (7 bits per byte, low
+ * bits first):
+ *
+ *   sequence       delta of the delta
+ *   timestamp      delta of the delta, microseconds
+ *   temperature    delta, 0.01 DegC
+ *   pressure       delta, Pa
+ *   humidity       delta, 1/1024 %rH
+ *
+ * Deltas are taken against the previous sample of the same sensor in
+ * the series, the first sample of a sensor against zero, so it goes out
+ * in full. Sequence and timestamp advance by about the same step every
+ * pass and take one or two bytes, slow channels one byte each. Unlike
+ * the records of telemetry_wire.h the values keep their full range and
+ * resolution.
+ */
+
+#ifndef TELEMETRY_DELTA_H
+#define TELEMETRY_DELTA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry.h"
+#include "telemetry_wire.h"
+
+#define TELEMETRY_DELTA_VERSION 2
+#define TELEMETRY_DELTA_HEADER_SIZE 3
+//sensor byte and five 64 bit varints
+#define TELEMETRY_DELTA_SAMPLE_MAX_SIZE (1 + 5*10)
+#define TELEMETRY_DELTA_MAX_SENSORS 8
+
+//last sample of a sensor, values are kept modulo 2^64
+typedef struct {
+    uint8_t sensor;
+    uint64_t sequence;
+    uint64_t sequence_delta;
+    uint64_t timestamp;
+    uint64_t timestamp_delta;
+    uint64_t temperature;
+    uint64_t pressure;
+    uint64_t humidity;
+} telemetry_delta_sensor_t;
+
+typedef struct {
+    uint8_t *buffer;
+    size_t size;
+    size_t length;
+    uint8_t sensor_count;
+    telemetry_delta_sensor_t sensors[TELEMETRY_DELTA_MAX_SENSORS];
+} telemetry_delta_encoder_t;
+
+typedef struct {
+    const uint8_t *buffer;
+    size_t length;
+    size_t offset;
+    uint16_t node_id;
+    uint8_t sensor_count;
+    telemetry_delta_sensor_t sensors[TELEMETRY_DELTA_MAX_SENSORS];
+} telemetry_delta_decoder_t;
+
+//starts a series in buffer, returns the header length, 0 when the buffer is too small
+size_t telemetry_delta_begin(telemetry_delta_encoder_t *encoder, uint16_t node_id, uint8_t *buffer, size_t size);
+//returns the bytes appended, 0 when the sample doesn't fit or the series has too many sensors
+size_t telemetry_delta_append(telemetry_delta_encoder_t *encoder, const telemetry_sample_t *sample);
+
+//returns 0, -1 for a short buffer or another version
+int telemetry_delta_decoder_init(telemetry_delta_decoder_t *decoder, const uint8_t *buffer, size_t length);
+//returns 1 for a decoded sample, 0 at the end of the series, -1 for a corrupt series
+int telemetry_delta_next(telemetry_delta_decoder_t *decoder, telemetry_wire_record_t *record);
+
+#endif /* TELEMETRY_DELTA_H */
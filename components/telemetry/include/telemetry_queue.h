@@ -0,0 +1,49 @@
+/*
+ * File:   telemetry_queue.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Lock-free sample queue between exactly one producer and one consumer,
+ * e.g. a sampling task and a transmit task on different cores. Head and
+ * tail are free running counters updated with atomics, nothing blocks
+ * and no lock is taken. When the queue is full a push either drops the
+ * oldest sample (TELEMETRY_QUEUE_DROP_OLDEST) or is refused so the
+ * producer can wait for room (TELEMETRY_QUEUE_BLOCK). To drop, the
+ * producer moves the tail itself; a consumer that raced with it throws
+ * away the copy it made and reads the new oldest sample.
+ */
+
+#ifndef TELEMETRY_QUEUE_H
+#define TELEMETRY_QUEUE_H
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+typedef enum {
+    TELEMETRY_QUEUE_DROP_OLDEST,
+    TELEMETRY_QUEUE_BLOCK
+} telemetry_queue_policy_t;
+
+typedef struct {
+    telemetry_sample_t *entries;
+    uint32_t capacity;          //power of two, the counters wrap around
+    telemetry_queue_policy_t policy;
+    uint32_t head;              //next entry to write, producer only
+    uint32_t tail;              //oldest entry, consumer and dropping producer
+    uint32_t dropped;           //samples dropped by a full drop oldest queue
+    uint32_t refused;           //pushes refused by a full blocking queue
+    uint32_t max_count;         //high water mark
+} telemetry_queue_t;
+
+//returns 0, -1 when capacity isn't a power of two
+int telemetry_queue_init(telemetry_queue_t *queue, telemetry_sample_t *entries, uint32_t capacity, telemetry_queue_policy_t policy);
+//producer side, returns 0, 1 when the oldest sample was dropped, -1 when a blocking queue is full
+int telemetry_queue_push(telemetry_queue_t *queue, const telemetry_sample_t *sample);
+//consumer side, returns 0, -1 when the queue is empty
+int telemetry_queue_pop(telemetry_queue_t *queue, telemetry_sample_t *sample);
+uint32_t telemetry_queue_count(telemetry_queue_t *queue);
+uint32_t telemetry_queue_dropped(telemetry_queue_t *queue);
+uint32_t telemetry_queue_refused(telemetry_queue_t *queue);
+uint32_t telemetry_queue_max_count(telemetry_queue_t *queue);
+
+#endif /* TELEMETRY_QUEUE_H */
@@ -0,0 +1,51 @@
+/*
+ * File:   telemetry_ring.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Fixed size sample ring meant for RTC slow memory. Every entry carries
+ * a CRC32 and the ring state is written alternately to two header slots
+ * with a generation count, so a reset in the middle of an update loses
+ * at most the sample being written. When full, the oldest sample is
+ * dropped.
+ */
+
+#ifndef TELEMETRY_RING_H
+#define TELEMETRY_RING_H
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+#define TELEMETRY_RING_MAGIC 0x52323830
+
+typedef struct {
+    telemetry_sample_t sample;
+    uint32_t crc;
+} telemetry_ring_entry_t;
+
+typedef struct {
+    uint32_t generation;
+    uint16_t head;          //index of the oldest entry
+    uint16_t count;
+    uint32_t dropped;       //samples lost to overflow or corruption
+    uint32_t crc;
+} telemetry_ring_header_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t capacity;
+    telemetry_ring_header_t headers[2];
+    telemetry_ring_entry_t *entries;
+} telemetry_ring_t;
+
+//returns 1 when the previous contents were recovered, 0 when the ring was reset
+int telemetry_ring_attach(telemetry_ring_t *ring, telemetry_ring_entry_t *entries, uint16_t capacity);
+void telemetry_ring_push(telemetry_ring_t *ring, const telemetry_sample_t *sample);
+//index 0 is the oldest sample, returns -1 when the entry fails its CRC
+int telemetry_ring_peek(const telemetry_ring_t *ring, uint16_t index, telemetry_sample_t *sample);
+//drops the count oldest samples, e.g. after they were sent
+void telemetry_ring_consume(telemetry_ring_t *ring, uint16_t count);
+uint16_t telemetry_ring_count(const telemetry_ring_t *ring);
+uint32_t telemetry_ring_dropped(const telemetry_ring_t *ring);
+
+#endif /* TELEMETRY_RING_H */
@@ -0,0 +1,28 @@
+/*
+ * File:   telemetry_stats.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Running count, mean, variance, min and max of a series of values,
+ * updated in one pass with Welford's method so no value has to be kept.
+ */
+
+#ifndef TELEMETRY_STATS_H
+#define TELEMETRY_STATS_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t count;
+    double mean;
+    double m2;              //sum of squared differences to the mean
+    double min;
+    double max;
+} telemetry_stats_t;
+
+void telemetry_stats_reset(telemetry_stats_t *stats);
+void telemetry_stats_add(telemetry_stats_t *stats, double value);
+//sample variance and standard deviation, 0 for less than two values
+double telemetry_stats_variance(const telemetry_stats_t *stats);
+double telemetry_stats_stddev(const telemetry_stats_t *stats);
+
+#endif /* TELEMETRY_STATS_H */
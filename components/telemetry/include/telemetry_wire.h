@@ -0,0 +1,71 @@
+/*
+ * File:   telemetry_wire.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Binary wire format of telemetry samples. A sample record is 24 bytes,
+ * every field little endian:
+ *
+ *   offset  size  field
+ *        0     1  version, TELEMETRY_WIRE_VERSION
+ *        1     1  sensor, I2C address of the BME280
+ *        2     2  node id
+ *        4     4  sequence, counts every sample of the node
+ *        8     8  timestamp, microseconds of the node clock
+ *       16     2  temperature, signed, 0.01 DegC
+ *       18     2  humidity, 1/512 %rH
+ *       20     4  pressure, Pa
+ *
+ * Temperature and pressure are the int32 compensation outputs as they
+ * are, humidity is the int32 output (1/1024 %rH) shifted right by one,
+ * the resolution of the 16 bit humidity output of the driver.
+ *
+ * A window summary record is 72 bytes, every field little endian:
+ *
+ *   offset  size  field
+ *        0     1  version, TELEMETRY_WIRE_SUMMARY_VERSION
+ *        1     1  sensor, I2C address of the BME280
+ *        2     2  node id
+ *        4     4  sequence, counts every summary of the node
+ *        8     8  window start, microseconds of the node clock
+ *       16     4  window length, microseconds
+ *       20     4  number of samples in the window
+ *       24    16  temperature, 0.01 DegC
+ *       40    16  pressure, Pa
+ *       56    16  humidity, 1/1024 %rH
+ *
+ * Each channel is min and max as signed int32, then mean and standard
+ * deviation as IEEE 754 float32.
+ *
+ * Decoders reject records of another version, a new layout gets a new
+ * version number.
+ */
+
+#ifndef TELEMETRY_WIRE_H
+#define TELEMETRY_WIRE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry.h"
+
+#define TELEMETRY_WIRE_VERSION 1
+#define TELEMETRY_WIRE_RECORD_SIZE 24
+#define TELEMETRY_WIRE_SUMMARY_VERSION 3
+#define TELEMETRY_WIRE_SUMMARY_SIZE 72
+
+typedef struct {
+    uint16_t node_id;
+    telemetry_sample_t sample;
+} telemetry_wire_record_t;
+
+//returns the bytes written, 0 when the buffer is too small
+size_t telemetry_wire_encode(const telemetry_sample_t *sample, uint16_t node_id, uint8_t *buffer, size_t size);
+//returns the bytes read, 0 for a short buffer or another version
+size_t telemetry_wire_decode(const uint8_t *buffer, size_t length, telemetry_wire_record_t *record);
+
+//same conventions for window summaries, decoded statistics are rebuilt
+//from the float32 mean and standard deviation
+size_t telemetry_wire_encode_summary(const telemetry_summary_t *summary, uint16_t node_id, uint8_t *buffer, size_t size);
+size_t telemetry_wire_decode_summary(const uint8_t *buffer, size_t length, uint16_t *node_id, telemetry_summary_t *summary);
+
+#endif /* TELEMETRY_WIRE_H */
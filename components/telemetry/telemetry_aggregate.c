@@ -0,0 +1,117 @@
+/*
+ * File:   telemetry_aggregate.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Windowed aggregation of the sample stream.
+ */
+
+#include <stddef.h>
+
+#include "telemetry_aggregate.h"
+
+static void telemetry_aggregate_channel_add(telemetry_aggregate_channel_t *channel, uint32_t count, int32_t value) {
+    int64_t difference;
+
+    if (count == 1) {
+        channel->offset = value;
+        channel->min = value;
+        channel->max = value;
+        channel->sum = 0;
+        channel->square_sum = 0;
+        return;
+    }
+    difference = (int64_t)value - channel->offset;
+    channel->sum += difference;
+    channel->square_sum += (uint64_t)(difference*difference);
+    if (value < channel->min) {
+        channel->min = value;
+    }
+    if (value > channel->max) {
+        channel->max = value;
+    }
+}
+
+static void telemetry_aggregate_channel_stats(const telemetry_aggregate_channel_t *channel, uint32_t count, telemetry_stats_t *stats) {
+    double mean = (double)channel->sum/count;
+    //the sums are taken around a value of the window, the subtraction loses no precision
+    double m2 = (double)channel->square_sum - mean*(double)channel->sum;
+
+    stats->count = count;
+    stats->mean = channel->offset + mean;
+    stats->m2 = (m2 > 0) ? m2 : 0;
+    stats->min = channel->min;
+    stats->max = channel->max;
+}
+
+static void telemetry_aggregate_open(telemetry_aggregate_t *aggregate, telemetry_aggregate_window_t *window, uint64_t timestamp) {
+    window->summary.start_usec = timestamp - (timestamp % aggregate->window_usec);
+    window->summary.length_usec = aggregate->window_usec;
+    window->count = 0;
+}
+
+static void telemetry_aggregate_close(telemetry_aggregate_t *aggregate, telemetry_aggregate_window_t *window) {
+    if (window->count == 0) {
+        return;
+    }
+    telemetry_aggregate_channel_stats(&window->temperature, window->count, &window->summary.temperature);
+    telemetry_aggregate_channel_stats(&window->pressure, window->count, &window->summary.pressure);
+    telemetry_aggregate_channel_stats(&window->humidity, window->count, &window->summary.humidity);
+    window->summary.sequence = aggregate->sequence++;
+    (*aggregate->emit)(aggregate->context, &window->summary);
+    //a flush leaves the window open and empty, all channels start over
+    telemetry_aggregate_open(aggregate, window, window->summary.start_usec);
+}
+
+void telemetry_aggregate_init(telemetry_aggregate_t *aggregate, uint32_t window_usec,
+                              telemetry_aggregate_emit_t emit, void *context) {
+    aggregate->window_usec = window_usec;
+    aggregate->sensor_count = 0;
+    aggregate->emit = emit;
+    aggregate->context = context;
+    aggregate->sequence = 0;
+    aggregate->late = 0;
+    aggregate->unknown = 0;
+}
+
+void telemetry_aggregate_add(telemetry_aggregate_t *aggregate, const telemetry_sample_t *sample) {
+    telemetry_aggregate_window_t *window = NULL;
+    uint8_t i;
+
+    for (i = 0; i < aggregate->sensor_count; i++) {
+        if (aggregate->windows[i].summary.sensor == sample->sensor) {
+            window = &aggregate->windows[i];
+            break;
+        }
+    }
+    if (window == NULL) {
+        if (aggregate->sensor_count >= TELEMETRY_AGGREGATE_MAX_SENSORS) {
+            aggregate->unknown++;
+            return;
+        }
+        window = &aggregate->windows[aggregate->sensor_count++];
+        window->summary.sensor = sample->sensor;
+        telemetry_aggregate_open(aggregate, window, sample->timestamp_usec);
+    }
+
+    if (sample->timestamp_usec < window->summary.start_usec) {
+        aggregate->late++;
+        return;
+    }
+    if ((sample->timestamp_usec - window->summary.start_usec) >= window->summary.length_usec) {
+        telemetry_aggregate_close(aggregate, window);
+        telemetry_aggregate_open(aggregate, window, sample->timestamp_usec);
+    }
+
+    window->count++;
+    telemetry_aggregate_channel_add(&window->temperature, window->count, sample->temperature);
+    telemetry_aggregate_channel_add(&window->pressure, window->count, (int32_t)sample->pressure);
+    telemetry_aggregate_channel_add(&window->humidity, window->count, (int32_t)sample->humidity);
+}
+
+void telemetry_aggregate_flush(telemetry_aggregate_t *aggregate) {
+    uint8_t i;
+
+    for (i = 0; i < aggregate->sensor_count; i++) {
+        telemetry_aggregate_close(aggregate, &aggregate->windows[i]);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * File:   telemetry_batch.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Packs several samples into one datagram.
+ */
+
+#include "telemetry_batch.h"
+
+static size_t telemetry_batch_append(telemetry_batch_t *batch, const telemetry_sample_t *sample) {
+    size_t length;
+
+    if (batch->format == TELEMETRY_BATCH_RECORDS) {
+        length = telemetry_wire_encode(sample, batch->node_id, &batch->data[batch->length],
+                                       sizeof(batch->data) - batch->length);
+    }
+    else {
+        if (batch->count == 0) {
+            batch->length = telemetry_delta_begin(&batch->delta, batch->node_id, batch->data, sizeof(batch->data));
+        }
+        length = telemetry_delta_append(&batch->delta, sample);
+    }
+    batch->length += length;
+
+    return length;
+}
+
+//room for another sample of the worst case size
+static uint8_t telemetry_batch_is_full(const telemetry_batch_t *batch) {
+    size_t sample_size = (batch->format == TELEMETRY_BATCH_RECORDS) ? TELEMETRY_WIRE_RECORD_SIZE : TELEMETRY_DELTA_SAMPLE_MAX_SIZE;
+
+    return ((sizeof(batch->data) - batch->length) < sample_size);
+}
+
+void telemetry_batch_init(telemetry_batch_t *batch, uint16_t node_id, telemetry_batch_format_t format,
+                          uint16_t max_count, uint64_t max_age_usec, telemetry_batch_send_t send, void *context) {
+    batch->length = 0;
+    batch->format = format;
+    batch->count = 0;
+    batch->max_count = (max_count == 0) ? UINT16_MAX : max_count;
+    batch->max_age_usec = max_age_usec;
+    batch->oldest_usec = 0;
+    batch->node_id = node_id;
+    batch->send = send;
+    batch->context = context;
+    batch->datagrams = 0;
+    batch->samples = 0;
+}
+
+void telemetry_batch_add(telemetry_batch_t *batch, const telemetry_sample_t *sample, uint64_t now_usec) {
+    //a delta series only takes a limited number of sensors
+    if ((telemetry_batch_append(batch, sample) == 0) && (batch->count > 0)) {
+        telemetry_batch_flush(batch);
+        telemetry_batch_append(batch, sample);
+    }
+    if (batch->count == 0) {
+        batch->oldest_usec = now_usec;
+    }
+    batch->count++;
+
+    if ((batch->count >= batch->max_count) || telemetry_batch_is_full(batch)) {
+        telemetry_batch_flush(batch);
+    }
+    else {
+        telemetry_batch_poll(batch, now_usec);
+    }
+}
+
+void telemetry_batch_poll(telemetry_batch_t *batch, uint64_t now_usec) {
+    if ((batch->count > 0) && (batch->max_age_usec > 0) && ((now_usec - batch->oldest_usec) >= batch->max_age_usec)) {
+        telemetry_batch_flush(batch);
+    }
+}
+
+void telemetry_batch_flush(telemetry_batch_t *batch) {
+    if (batch->count == 0) {
+        return;
+    }
+
+    (*batch->send)(batch->context, batch->data, batch->length);
+    batch->datagrams++;
+    batch->samples += batch->count;
+    batch->length = 0;
+    batch->count = 0;
+}
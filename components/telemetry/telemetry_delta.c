@@ -0,0 +1,174 @@
+/*
+ * File:   telemetry_delta.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Delta coded series of telemetry samples.
+ */
+
+#include <string.h>
+
+#include "telemetry_delta.h"
+
+static size_t telemetry_delta_put(uint8_t *buffer, uint64_t delta) {
+    //zig-zag: small negative deltas get small codes too
+    uint64_t value = (delta << 1) ^ (uint64_t)((int64_t)delta >> 63);
+    size_t length = 0;
+
+    while (value >= 0x80) {
+        buffer[length++] = (value & 0x7f) | 0x80;
+        value >>= 7;
+    }
+    buffer[length++] = value;
+
+    return length;
+}
+
+static int telemetry_delta_get(telemetry_delta_decoder_t *decoder, uint64_t *delta) {
+    uint64_t value = 0;
+    uint8_t shift, byte;
+
+    for (shift = 0; shift < 64; shift += 7) {
+        if (decoder->offset >= decoder->length) {
+            return -1;
+        }
+        byte = decoder->buffer[decoder->offset++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *delta = (value >> 1) ^ (0 - (value & 1));
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+//NULL when the sensor is new and every slot is used
+static telemetry_delta_sensor_t *telemetry_delta_find(telemetry_delta_sensor_t *sensors, uint8_t *sensor_count, uint8_t sensor) {
+    uint8_t i;
+
+    for (i = 0; i < *sensor_count; i++) {
+        if (sensors[i].sensor == sensor) {
+            return &sensors[i];
+        }
+    }
+    if (*sensor_count >= TELEMETRY_DELTA_MAX_SENSORS) {
+        return NULL;
+    }
+
+    memset(&sensors[i], 0, sizeof(sensors[i]));
+    sensors[i].sensor = sensor;
+    (*sensor_count)++;
+
+    return &sensors[i];
+}
+
+size_t telemetry_delta_begin(telemetry_delta_encoder_t *encoder, uint16_t node_id, uint8_t *buffer, size_t size) {
+    encoder->buffer = buffer;
+    encoder->size = size;
+    encoder->length = 0;
+    encoder->sensor_count = 0;
+
+    if (size < TELEMETRY_DELTA_HEADER_SIZE) {
+        return 0;
+    }
+    buffer[0] = TELEMETRY_DELTA_VERSION;
+    buffer[1] = node_id & 0xff;
+    buffer[2] = node_id >> 8;
+    encoder->length = TELEMETRY_DELTA_HEADER_SIZE;
+
+    return TELEMETRY_DELTA_HEADER_SIZE;
+}
+
+size_t telemetry_delta_append(telemetry_delta_encoder_t *encoder, const telemetry_sample_t *sample) {
+    uint8_t data[TELEMETRY_DELTA_SAMPLE_MAX_SIZE];
+    telemetry_delta_sensor_t *last;
+    uint64_t sequence_delta, timestamp_delta;
+    uint8_t sensor_count = encoder->sensor_count;
+    size_t length = 0;
+
+    if (encoder->length == 0) {
+        return 0;
+    }
+    last = telemetry_delta_find(encoder->sensors, &sensor_count, sample->sensor);
+    if (last == NULL) {
+        return 0;
+    }
+
+    sequence_delta = sample->sequence - last->sequence;
+    timestamp_delta = sample->timestamp_usec - last->timestamp;
+
+    data[length++] = sample->sensor;
+    length += telemetry_delta_put(&data[length], sequence_delta - last->sequence_delta);
+    length += telemetry_delta_put(&data[length], timestamp_delta - last->timestamp_delta);
+    length += telemetry_delta_put(&data[length], (uint64_t)(int64_t)sample->temperature - last->temperature);
+    length += telemetry_delta_put(&data[length], (uint64_t)sample->pressure - last->pressure);
+    length += telemetry_delta_put(&data[length], (uint64_t)sample->humidity - last->humidity);
+    //a sample that doesn't fit leaves the series as it was
+    if (length > (encoder->size - encoder->length)) {
+        return 0;
+    }
+
+    memcpy(&encoder->buffer[encoder->length], data, length);
+    encoder->length += length;
+    encoder->sensor_count = sensor_count;
+    last->sequence = sample->sequence;
+    last->sequence_delta = sequence_delta;
+    last->timestamp = sample->timestamp_usec;
+    last->timestamp_delta = timestamp_delta;
+    last->temperature = (uint64_t)(int64_t)sample->temperature;
+    last->pressure = sample->pressure;
+    last->humidity = sample->humidity;
+
+    return length;
+}
+
+int telemetry_delta_decoder_init(telemetry_delta_decoder_t *decoder, const uint8_t *buffer, size_t length) {
+    if ((length < TELEMETRY_DELTA_HEADER_SIZE) || (buffer[0] != TELEMETRY_DELTA_VERSION)) {
+        return -1;
+    }
+
+    decoder->buffer = buffer;
+    decoder->length = length;
+    decoder->offset = TELEMETRY_DELTA_HEADER_SIZE;
+    decoder->node_id = buffer[1] | (buffer[2] << 8);
+    decoder->sensor_count = 0;
+
+    return 0;
+}
+
+int telemetry_delta_next(telemetry_delta_decoder_t *decoder, telemetry_wire_record_t *record) {
+    telemetry_delta_sensor_t *last;
+    uint64_t delta[5];
+    uint8_t i;
+
+    if (decoder->offset >= decoder->length) {
+        return 0;
+    }
+    last = telemetry_delta_find(decoder->sensors, &decoder->sensor_count, decoder->buffer[decoder->offset++]);
+    if (last == NULL) {
+        return -1;
+    }
+    for (i = 0; i < 5; i++) {
+        if (telemetry_delta_get(decoder, &delta[i]) != 0) {
+            return -1;
+        }
+    }
+
+    last->sequence_delta += delta[0];
+    last->sequence += last->sequence_delta;
+    last->timestamp_delta += delta[1];
+    last->timestamp += last->timestamp_delta;
+    last->temperature += delta[2];
+    last->pressure += delta[3];
+    last->humidity += delta[4];
+
+    record->node_id = decoder->node_id;
+    record->sample.sensor = last->sensor;
+    record->sample.sequence = last->sequence;
+    record->sample.timestamp_usec = last->timestamp;
+    record->sample.temperature = (int32_t)(int64_t)last->temperature;
+    record->sample.pressure = last->pressure;
+    record->sample.humidity = last->humidity;
+
+    return 1;
+}
@@ -0,0 +1,88 @@
+/*
+ * File:   telemetry_queue.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Lock-free single producer, single consumer sample queue.
+ */
+
+#include "telemetry_queue.h"
+
+int telemetry_queue_init(telemetry_queue_t *queue, telemetry_sample_t *entries, uint32_t capacity, telemetry_queue_policy_t policy) {
+    if ((capacity == 0) || ((capacity & (capacity - 1)) != 0)) {
+        return -1;
+    }
+
+    queue->entries = entries;
+    queue->capacity = capacity;
+    queue->policy = policy;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped = 0;
+    queue->refused = 0;
+    queue->max_count = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    return 0;
+}
+
+int telemetry_queue_push(telemetry_queue_t *queue, const telemetry_sample_t *sample) {
+    uint32_t head = queue->head;
+    uint32_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    uint32_t count;
+    int result = 0;
+
+    if ((head - tail) >= queue->capacity) {
+        if (queue->policy == TELEMETRY_QUEUE_BLOCK) {
+            __atomic_store_n(&queue->refused, queue->refused + 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+        //fails only when the consumer just took the oldest sample, then there is room anyway
+        if (__atomic_compare_exchange_n(&queue->tail, &tail, tail + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&queue->dropped, queue->dropped + 1, __ATOMIC_RELAXED);
+            result = 1;
+        }
+    }
+
+    queue->entries[head & (queue->capacity - 1)] = *sample;
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+
+    count = head + 1 - __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    if (count > queue->max_count) {
+        __atomic_store_n(&queue->max_count, count, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+int telemetry_queue_pop(telemetry_queue_t *queue, telemetry_sample_t *sample) {
+    uint32_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+
+    while (1) {
+        if (tail == __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)) {
+            return -1;
+        }
+        *sample = queue->entries[tail & (queue->capacity - 1)];
+        //the producer moved the tail while the entry was copied, the copy may be torn
+        if (__atomic_compare_exchange_n(&queue->tail, &tail, tail + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+    }
+}
+
+uint32_t telemetry_queue_count(telemetry_queue_t *queue) {
+    uint32_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+
+    return __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE) - tail;
+}
+
+uint32_t telemetry_queue_dropped(telemetry_queue_t *queue) {
+    return __atomic_load_n(&queue->dropped, __ATOMIC_RELAXED);
+}
+
+uint32_t telemetry_queue_refused(telemetry_queue_t *queue) {
+    return __atomic_load_n(&queue->refused, __ATOMIC_RELAXED);
+}
+
+uint32_t telemetry_queue_max_count(telemetry_queue_t *queue) {
+    return __atomic_load_n(&queue->max_count, __ATOMIC_RELAXED);
+}
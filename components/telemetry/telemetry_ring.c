@@ -0,0 +1,144 @@
+/*
+ * File:   telemetry_ring.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Fixed size sample ring meant for RTC slow memory.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "telemetry_ring.h"
+
+//CRC-32 (IEEE), bitwise: a few entries per wake-up don't need a table
+static uint32_t telemetry_ring_crc32(uint32_t crc, const void *data, size_t length) {
+    const uint8_t *bytes = data;
+    uint8_t bit;
+
+    crc = ~crc;
+    while (length-- > 0) {
+        crc ^= *bytes++;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t telemetry_ring_header_crc(const telemetry_ring_t *ring, const telemetry_ring_header_t *header) {
+    //the capacity is covered too, a resized ring is not recovered
+    uint32_t crc = telemetry_ring_crc32(0, &ring->capacity, sizeof(ring->capacity));
+
+    return telemetry_ring_crc32(crc, header, offsetof(telemetry_ring_header_t, crc));
+}
+
+static int telemetry_ring_header_valid(const telemetry_ring_t *ring, const telemetry_ring_header_t *header) {
+    return (header->crc == telemetry_ring_header_crc(ring, header)) &&
+           (header->head < ring->capacity) && (header->count <= ring->capacity);
+}
+
+static const telemetry_ring_header_t *telemetry_ring_current(const telemetry_ring_t *ring) {
+    return (ring->headers[0].generation >= ring->headers[1].generation) ? &ring->headers[0] : &ring->headers[1];
+}
+
+//the older slot is overwritten, the current one stays valid until the new one is complete
+static void telemetry_ring_commit(telemetry_ring_t *ring, uint16_t head, uint16_t count, uint32_t dropped) {
+    const telemetry_ring_header_t *current = telemetry_ring_current(ring);
+    telemetry_ring_header_t *next = (current == &ring->headers[0]) ? &ring->headers[1] : &ring->headers[0];
+    telemetry_ring_header_t header = {
+        .generation = current->generation + 1,
+        .head = head,
+        .count = count,
+        .dropped = dropped
+    };
+
+    //a slot is only current once its generation is written, which goes last
+    header.crc = telemetry_ring_header_crc(ring, &header);
+    next->generation = 0;
+    next->head = header.head;
+    next->count = header.count;
+    next->dropped = header.dropped;
+    next->crc = header.crc;
+    next->generation = header.generation;
+}
+
+int telemetry_ring_attach(telemetry_ring_t *ring, telemetry_ring_entry_t *entries, uint16_t capacity) {
+    uint8_t is_valid[2];
+
+    ring->entries = entries;
+    if ((ring->magic == TELEMETRY_RING_MAGIC) && (ring->capacity == capacity) && (capacity > 0)) {
+        is_valid[0] = telemetry_ring_header_valid(ring, &ring->headers[0]);
+        is_valid[1] = telemetry_ring_header_valid(ring, &ring->headers[1]);
+        if (is_valid[0] || is_valid[1]) {
+            //an interrupted commit leaves one broken slot, keep the other one current
+            if (!is_valid[0]) {
+                ring->headers[0].generation = 0;
+            }
+            if (!is_valid[1]) {
+                ring->headers[1].generation = 0;
+            }
+            return 1;
+        }
+    }
+
+    ring->magic = 0;
+    ring->capacity = capacity;
+    memset(ring->headers, 0, sizeof(ring->headers));
+    telemetry_ring_commit(ring, 0, 0, 0);
+    ring->magic = TELEMETRY_RING_MAGIC;
+    return 0;
+}
+
+void telemetry_ring_push(telemetry_ring_t *ring, const telemetry_sample_t *sample) {
+    const telemetry_ring_header_t *current = telemetry_ring_current(ring);
+    uint16_t head = current->head, count = current->count;
+    uint32_t dropped = current->dropped;
+    telemetry_ring_entry_t *entry;
+
+    if (count == ring->capacity) {
+        //the slot of the oldest sample is reused, drop it first
+        head = (head + 1)%ring->capacity;
+        count--;
+        dropped++;
+        telemetry_ring_commit(ring, head, count, dropped);
+    }
+
+    entry = &ring->entries[(head + count)%ring->capacity];
+    memset(entry, 0, sizeof(*entry));
+    entry->sample = *sample;
+    entry->crc = telemetry_ring_crc32(0, &entry->sample, sizeof(entry->sample));
+
+    telemetry_ring_commit(ring, head, count + 1, dropped);
+}
+
+int telemetry_ring_peek(const telemetry_ring_t *ring, uint16_t index, telemetry_sample_t *sample) {
+    const telemetry_ring_header_t *current = telemetry_ring_current(ring);
+    const telemetry_ring_entry_t *entry;
+
+    if (index >= current->count) {
+        return -1;
+    }
+    entry = &ring->entries[(current->head + index)%ring->capacity];
+    if (entry->crc != telemetry_ring_crc32(0, &entry->sample, sizeof(entry->sample))) {
+        return -1;
+    }
+    *sample = entry->sample;
+    return 0;
+}
+
+void telemetry_ring_consume(telemetry_ring_t *ring, uint16_t count) {
+    const telemetry_ring_header_t *current = telemetry_ring_current(ring);
+
+    if (count > current->count) {
+        count = current->count;
+    }
+    telemetry_ring_commit(ring, (current->head + count)%ring->capacity, current->count - count, current->dropped);
+}
+
+uint16_t telemetry_ring_count(const telemetry_ring_t *ring) {
+    return telemetry_ring_current(ring)->count;
+}
+
+uint32_t telemetry_ring_dropped(const telemetry_ring_t *ring) {
+    return telemetry_ring_current(ring)->dropped;
+}
@@ -0,0 +1,45 @@
+/*
+ * File:   telemetry_stats.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Running statistics with Welford's method.
+ */
+
+#include <math.h>
+
+#include "telemetry_stats.h"
+
+void telemetry_stats_reset(telemetry_stats_t *stats) {
+    stats->count = 0;
+    stats->mean = 0;
+    stats->m2 = 0;
+    stats->min = 0;
+    stats->max = 0;
+}
+
+void telemetry_stats_add(telemetry_stats_t *stats, double value) {
+    double delta = value - stats->mean;
+
+    stats->count++;
+    stats->mean += delta/stats->count;
+    //the second factor uses the updated mean, no large sum of squares loses precision
+    stats->m2 += delta*(value - stats->mean);
+
+    if ((stats->count == 1) || (value < stats->min)) {
+        stats->min = value;
+    }
+    if ((stats->count == 1) || (value > stats->max)) {
+        stats->max = value;
+    }
+}
+
+double telemetry_stats_variance(const telemetry_stats_t *stats) {
+    if (stats->count < 2) {
+        return 0;
+    }
+    return stats->m2/(stats->count - 1);
+}
+
+double telemetry_stats_stddev(const telemetry_stats_t *stats) {
+    return sqrt(telemetry_stats_variance(stats));
+}
@@ -0,0 +1,138 @@
+/*
+ * File:   telemetry_wire.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Binary wire format of telemetry samples.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "telemetry_wire.h"
+
+static void telemetry_wire_put(uint8_t *buffer, uint64_t value, uint8_t size) {
+    uint8_t i;
+
+    for (i = 0; i < size; i++) {
+        buffer[i] = (value >> (8*i)) & 0xff;
+    }
+}
+
+static uint64_t telemetry_wire_get(const uint8_t *buffer, uint8_t size) {
+    uint64_t value = 0;
+    uint8_t i;
+
+    for (i = 0; i < size; i++) {
+        value |= (uint64_t)buffer[i] << (8*i);
+    }
+    return value;
+}
+
+size_t telemetry_wire_encode(const telemetry_sample_t *sample, uint16_t node_id, uint8_t *buffer, size_t size) {
+    int32_t temperature = sample->temperature;
+
+    if (size < TELEMETRY_WIRE_RECORD_SIZE) {
+        return 0;
+    }
+    //out of range values are clamped instead of wrapping around
+    if (temperature > INT16_MAX) {
+        temperature = INT16_MAX;
+    }
+    else if (temperature < INT16_MIN) {
+        temperature = INT16_MIN;
+    }
+
+    buffer[0] = TELEMETRY_WIRE_VERSION;
+    buffer[1] = sample->sensor;
+    telemetry_wire_put(&buffer[2], node_id, 2);
+    telemetry_wire_put(&buffer[4], sample->sequence, 4);
+    telemetry_wire_put(&buffer[8], sample->timestamp_usec, 8);
+    telemetry_wire_put(&buffer[16], (uint16_t)(int16_t)temperature, 2);
+    telemetry_wire_put(&buffer[18], ((sample->humidity >> 1) > UINT16_MAX) ? UINT16_MAX : (sample->humidity >> 1), 2);
+    telemetry_wire_put(&buffer[20], sample->pressure, 4);
+
+    return TELEMETRY_WIRE_RECORD_SIZE;
+}
+
+size_t telemetry_wire_decode(const uint8_t *buffer, size_t length, telemetry_wire_record_t *record) {
+    if ((length < TELEMETRY_WIRE_RECORD_SIZE) || (buffer[0] != TELEMETRY_WIRE_VERSION)) {
+        return 0;
+    }
+
+    record->sample.sensor = buffer[1];
+    record->node_id = telemetry_wire_get(&buffer[2], 2);
+    record->sample.sequence = telemetry_wire_get(&buffer[4], 4);
+    record->sample.timestamp_usec = telemetry_wire_get(&buffer[8], 8);
+    record->sample.temperature = (int16_t)telemetry_wire_get(&buffer[16], 2);
+    record->sample.humidity = telemetry_wire_get(&buffer[18], 2) << 1;
+    record->sample.pressure = telemetry_wire_get(&buffer[20], 4);
+
+    return TELEMETRY_WIRE_RECORD_SIZE;
+}
+
+static void telemetry_wire_put_stats(uint8_t *buffer, const telemetry_stats_t *stats) {
+    float mean = stats->mean;
+    float stddev = telemetry_stats_stddev(stats);
+    uint32_t bits;
+
+    telemetry_wire_put(&buffer[0], (uint32_t)(int32_t)lround(stats->min), 4);
+    telemetry_wire_put(&buffer[4], (uint32_t)(int32_t)lround(stats->max), 4);
+    memcpy(&bits, &mean, 4);
+    telemetry_wire_put(&buffer[8], bits, 4);
+    memcpy(&bits, &stddev, 4);
+    telemetry_wire_put(&buffer[12], bits, 4);
+}
+
+static void telemetry_wire_get_stats(const uint8_t *buffer, uint32_t count, telemetry_stats_t *stats) {
+    float mean, stddev;
+    uint32_t bits;
+
+    stats->count = count;
+    stats->min = (int32_t)telemetry_wire_get(&buffer[0], 4);
+    stats->max = (int32_t)telemetry_wire_get(&buffer[4], 4);
+    bits = telemetry_wire_get(&buffer[8], 4);
+    memcpy(&mean, &bits, 4);
+    bits = telemetry_wire_get(&buffer[12], 4);
+    memcpy(&stddev, &bits, 4);
+    stats->mean = mean;
+    stats->m2 = (count > 1) ? (double)stddev*stddev*(count - 1) : 0;
+}
+
+size_t telemetry_wire_encode_summary(const telemetry_summary_t *summary, uint16_t node_id, uint8_t *buffer, size_t size) {
+    if (size < TELEMETRY_WIRE_SUMMARY_SIZE) {
+        return 0;
+    }
+
+    buffer[0] = TELEMETRY_WIRE_SUMMARY_VERSION;
+    buffer[1] = summary->sensor;
+    telemetry_wire_put(&buffer[2], node_id, 2);
+    telemetry_wire_put(&buffer[4], summary->sequence, 4);
+    telemetry_wire_put(&buffer[8], summary->start_usec, 8);
+    telemetry_wire_put(&buffer[16], summary->length_usec, 4);
+    telemetry_wire_put(&buffer[20], summary->temperature.count, 4);
+    telemetry_wire_put_stats(&buffer[24], &summary->temperature);
+    telemetry_wire_put_stats(&buffer[40], &summary->pressure);
+    telemetry_wire_put_stats(&buffer[56], &summary->humidity);
+
+    return TELEMETRY_WIRE_SUMMARY_SIZE;
+}
+
+size_t telemetry_wire_decode_summary(const uint8_t *buffer, size_t length, uint16_t *node_id, telemetry_summary_t *summary) {
+    uint32_t count;
+
+    if ((length < TELEMETRY_WIRE_SUMMARY_SIZE) || (buffer[0] != TELEMETRY_WIRE_SUMMARY_VERSION)) {
+        return 0;
+    }
+
+    summary->sensor = buffer[1];
+    *node_id = telemetry_wire_get(&buffer[2], 2);
+    summary->sequence = telemetry_wire_get(&buffer[4], 4);
+    summary->start_usec = telemetry_wire_get(&buffer[8], 8);
+    summary->length_usec = telemetry_wire_get(&buffer[16], 4);
+    count = telemetry_wire_get(&buffer[20], 4);
+    telemetry_wire_get_stats(&buffer[24], count, &summary->temperature);
+    telemetry_wire_get_stats(&buffer[40], count, &summary->pressure);
+    telemetry_wire_get_stats(&buffer[56], count, &summary->humidity);
+
+    return TELEMETRY_WIRE_SUMMARY_SIZE;
+}
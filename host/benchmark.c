@@ -0,0 +1,286 @@
+/*
+ * File:   benchmark.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Host microbenchmark of the bme280 compensation variants. Every variant
+ * compensates the same set of raw temperature/pressure/humidity triples,
+ * the best of several rounds is reported in ns per sample together with
+ * the largest deviation from the double precision result.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "bme280.h"
+#include "bme280_stub.h"
+
+#define BENCHMARK_SAMPLES 4096
+#define BENCHMARK_DEFAULT_ROUNDS 200
+
+typedef struct {
+    const char *name;
+    void (*run)(struct bme280_t *bme280);
+    void (*read)(uint32_t index, double *temperature, double *pressure, double *humidity);
+    //integer outputs: value*scale + offset gives DegC, Pa and %rH
+    double temperature_scale;
+    double temperature_offset;
+    double pressure_scale;
+    double humidity_scale;
+} benchmark_variant_t;
+
+static s32 uncomp_temperature[BENCHMARK_SAMPLES];
+static s32 uncomp_pressure[BENCHMARK_SAMPLES];
+static s32 uncomp_humidity[BENCHMARK_SAMPLES];
+
+static s32 result_temperature[BENCHMARK_SAMPLES];
+static u32 result_pressure[BENCHMARK_SAMPLES];
+static u32 result_humidity[BENCHMARK_SAMPLES];
+static double result_double[BENCHMARK_SAMPLES][3];
+static float result_float[BENCHMARK_SAMPLES][3];
+
+static double reference[BENCHMARK_SAMPLES][3];
+
+static const benchmark_variant_t *current_variant;
+
+static void run_int32(struct bme280_t *bme280) {
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        result_temperature[i] = bme280_compensate_temperature_int32(bme280, uncomp_temperature[i]);
+        result_pressure[i] = bme280_compensate_pressure_int32(bme280, uncomp_pressure[i]);
+        result_humidity[i] = bme280_compensate_humidity_int32(bme280, uncomp_humidity[i]);
+    }
+}
+
+static void run_int32_sixteen_bit_output(struct bme280_t *bme280) {
+    uint32_t i;
+
+    //there is no 16 bit pressure output, the 32 bit one is used
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        result_temperature[i] = bme280_compensate_temperature_int32_sixteen_bit_output(bme280, uncomp_temperature[i]);
+        result_pressure[i] = bme280_compensate_pressure_int32(bme280, uncomp_pressure[i]);
+        result_humidity[i] = bme280_compensate_humidity_int32_sixteen_bit_output(bme280, uncomp_humidity[i]);
+    }
+}
+
+static void run_int64(struct bme280_t *bme280) {
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        result_temperature[i] = bme280_compensate_temperature_int32(bme280, uncomp_temperature[i]);
+        result_pressure[i] = bme280_compensate_pressure_int64(bme280, uncomp_pressure[i]);
+        result_humidity[i] = bme280_compensate_humidity_int32(bme280, uncomp_humidity[i]);
+    }
+}
+
+static void run_int64_twentyfour_bit_output(struct bme280_t *bme280) {
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        result_temperature[i] = bme280_compensate_temperature_int32(bme280, uncomp_temperature[i]);
+        result_pressure[i] = bme280_compensate_pressure_int64_twentyfour_bit_output(bme280, uncomp_pressure[i]);
+        result_humidity[i] = bme280_compensate_humidity_int32(bme280, uncomp_humidity[i]);
+    }
+}
+
+static void run_double(struct bme280_t *bme280) {
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        result_double[i][0] = bme280_compensate_temperature_double(bme280, uncomp_temperature[i]);
+        result_double[i][1] = bme280_compensate_pressure_double(bme280, uncomp_pressure[i]);
+        result_double[i][2] = bme280_compensate_humidity_double(bme280, uncomp_humidity[i]);
+    }
+}
+
+static void run_float(struct bme280_t *bme280) {
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        result_float[i][0] = bme280_compensate_temperature_float(bme280, uncomp_temperature[i]);
+        result_float[i][1] = bme280_compensate_pressure_float(bme280, uncomp_pressure[i]);
+        result_float[i][2] = bme280_compensate_humidity_float(bme280, uncomp_humidity[i]);
+    }
+}
+
+static void run_all_int32(struct bme280_t *bme280) {
+    struct bme280_compensated_int32_t values;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        values = bme280_compensate_all_int32(bme280, uncomp_pressure[i], uncomp_temperature[i], uncomp_humidity[i]);
+        result_temperature[i] = values.temperature;
+        result_pressure[i] = values.pressure;
+        result_humidity[i] = values.humidity;
+    }
+}
+
+static void run_all_int64(struct bme280_t *bme280) {
+    struct bme280_compensated_int64_t values;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        values = bme280_compensate_all_int64(bme280, uncomp_pressure[i], uncomp_temperature[i], uncomp_humidity[i]);
+        result_temperature[i] = values.temperature;
+        result_pressure[i] = values.pressure;
+        result_humidity[i] = values.humidity;
+    }
+}
+
+static void run_all_double(struct bme280_t *bme280) {
+    struct bme280_compensated_double_t values;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        values = bme280_compensate_all_double(bme280, uncomp_pressure[i], uncomp_temperature[i], uncomp_humidity[i]);
+        result_double[i][0] = values.temperature;
+        result_double[i][1] = values.pressure;
+        result_double[i][2] = values.humidity;
+    }
+}
+
+static void run_all_float(struct bme280_t *bme280) {
+    struct bme280_compensated_float_t values;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        values = bme280_compensate_all_float(bme280, uncomp_pressure[i], uncomp_temperature[i], uncomp_humidity[i]);
+        result_float[i][0] = values.temperature;
+        result_float[i][1] = values.pressure;
+        result_float[i][2] = values.humidity;
+    }
+}
+
+static void run_int32_batch(struct bme280_t *bme280) {
+    bme280_compensate_int32_batch(bme280, uncomp_temperature, uncomp_pressure, uncomp_humidity,
+                                  result_temperature, result_pressure, result_humidity, BENCHMARK_SAMPLES);
+}
+
+static void read_integer(uint32_t index, double *temperature, double *pressure, double *humidity) {
+    *temperature = result_temperature[index]*current_variant->temperature_scale + current_variant->temperature_offset;
+    *pressure = result_pressure[index]*current_variant->pressure_scale;
+    *humidity = result_humidity[index]*current_variant->humidity_scale;
+}
+
+static void read_double(uint32_t index, double *temperature, double *pressure, double *humidity) {
+    *temperature = result_double[index][0];
+    *pressure = result_double[index][1];
+    *humidity = result_double[index][2];
+}
+
+static void read_float(uint32_t index, double *temperature, double *pressure, double *humidity) {
+    *temperature = result_float[index][0];
+    *pressure = result_float[index][1];
+    *humidity = result_float[index][2];
+}
+
+static const benchmark_variant_t benchmark_variants[] = {
+    {"int32", run_int32, read_integer, 0.01, 0, 1, 1.0/1024},
+    {"int32_sixteen_bit_output", run_int32_sixteen_bit_output, read_integer, 1.0/500, 24, 1, 1.0/512},
+    {"int64", run_int64, read_integer, 0.01, 0, 1.0/256, 1.0/1024},
+    {"int64_twentyfour_bit_output", run_int64_twentyfour_bit_output, read_integer, 0.01, 0, 1.0/128, 1.0/1024},
+    {"double", run_double, read_double, 1, 0, 1, 1},
+    {"float", run_float, read_float, 1, 0, 1, 1},
+    {"all_int32", run_all_int32, read_integer, 0.01, 0, 1, 1.0/1024},
+    {"all_int64", run_all_int64, read_integer, 0.01, 0, 1.0/256, 1.0/1024},
+    {"all_double", run_all_double, read_double, 1, 0, 1, 1},
+    {"all_float", run_all_float, read_float, 1, 0, 1, 1},
+    {"int32_batch", run_int32_batch, read_integer, 0.01, 0, 1, 1.0/1024}
+};
+
+static double benchmark_now_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec*1e9 + now.tv_nsec;
+}
+
+//raw values of -20..60 DegC, 300..1100 hPa and the whole humidity range
+static void benchmark_fill_inputs(void) {
+    uint32_t seed = 280;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        seed = seed*1664525 + 1013904223;
+        uncomp_temperature[i] = 400000 + (seed >> 8)%220000;
+        seed = seed*1664525 + 1013904223;
+        uncomp_pressure[i] = 240000 + (seed >> 8)%290000;
+        seed = seed*1664525 + 1013904223;
+        uncomp_humidity[i] = (seed >> 8)%65536;
+    }
+}
+
+static void benchmark_fill_reference(struct bme280_t *bme280) {
+    struct bme280_compensated_double_t values;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        values = bme280_compensate_all_double(bme280, uncomp_pressure[i], uncomp_temperature[i], uncomp_humidity[i]);
+        reference[i][0] = values.temperature;
+        reference[i][1] = values.pressure;
+        reference[i][2] = values.humidity;
+    }
+}
+
+static void benchmark_run_variant(struct bme280_t *bme280, const benchmark_variant_t *variant, uint32_t rounds) {
+    double best = 0, start, elapsed;
+    double temperature, pressure, humidity;
+    double max_temperature = 0, max_pressure = 0, max_humidity = 0;
+    uint32_t round, i;
+
+    current_variant = variant;
+    for (round = 0; round < rounds; round++) {
+        start = benchmark_now_ns();
+        (*variant->run)(bme280);
+        elapsed = benchmark_now_ns() - start;
+        if ((round == 0) || (elapsed < best)) {
+            best = elapsed;
+        }
+    }
+
+    for (i = 0; i < BENCHMARK_SAMPLES; i++) {
+        (*variant->read)(i, &temperature, &pressure, &humidity);
+        max_temperature = fmax(max_temperature, fabs(temperature - reference[i][0]));
+        max_pressure = fmax(max_pressure, fabs(pressure - reference[i][1]));
+        max_humidity = fmax(max_humidity, fabs(humidity - reference[i][2]));
+    }
+
+    printf("%-28s %10.2f %12.5f %12.4f %12.5f\n", variant->name, best/BENCHMARK_SAMPLES,
+           max_temperature, max_pressure, max_humidity);
+}
+
+int main(int argc, char **argv) {
+    struct bme280_t bme280;
+    uint32_t rounds = BENCHMARK_DEFAULT_ROUNDS;
+    uint32_t i;
+    int32_t result;
+
+    if (argc > 1) {
+        rounds = strtoul(argv[1], NULL, 10);
+        if (rounds == 0) {
+            fprintf(stderr, "usage: %s [rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    bme280_stub_reset();
+    bme280_stub_attach(&bme280, BME280_I2C_ADDRESS1);
+    result = bme280_init(&bme280);
+    if (result != SUCCESS) {
+        fprintf(stderr, "bme280_init failed: %d\n", result);
+        return 1;
+    }
+
+    benchmark_fill_inputs();
+    benchmark_fill_reference(&bme280);
+
+    printf("%u samples, best of %u rounds, deviation from double\n", BENCHMARK_SAMPLES, rounds);
+    printf("%-28s %10s %12s %12s %12s\n", "variant", "ns/sample", "max dT [C]", "max dP [Pa]", "max dH [%rH]");
+    for (i = 0; i < (sizeof(benchmark_variants)/sizeof(benchmark_variants[0])); i++) {
+        benchmark_run_variant(&bme280, &benchmark_variants[i], rounds);
+    }
+
+    return 0;
+}
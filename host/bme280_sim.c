@@ -0,0 +1,471 @@
+/*
+ * File:   bme280_sim.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Software BME280 for Linux hosts.
+ */
+
+#include <string.h>
+#include <math.h>
+
+#include "bme280_sim.h"
+
+//conversion times of the datasheet (9.1), typical and maximum
+#define BME280_SIM_INIT_NS_TYP 1000000
+#define BME280_SIM_INIT_NS_MAX 1250000
+#define BME280_SIM_PER_OSRS_NS_TYP 2000000
+#define BME280_SIM_PER_OSRS_NS_MAX 2300000
+#define BME280_SIM_SETUP_NS_TYP 500000
+#define BME280_SIM_SETUP_NS_MAX 575000
+
+//normal mode cycles simulated when the clock jumps far ahead,
+//the IIR filter has settled long before
+#define BME280_SIM_MAX_CATCH_UP_CYCLES 64
+
+#define BME280_SIM_ADC_SKIPPED 0x80000
+#define BME280_SIM_ADC_HUMIDITY_SKIPPED 0x8000
+
+//calibration example of the BME280 datasheet
+static const struct bme280_calibration_param_t bme280_sim_default_calibration = {
+    .dig_T1 = 27504, .dig_T2 = 26435, .dig_T3 = -1000,
+    .dig_P1 = 36477, .dig_P2 = -10685, .dig_P3 = 3024, .dig_P4 = 2855, .dig_P5 = 140,
+    .dig_P6 = -7, .dig_P7 = 15500, .dig_P8 = -14600, .dig_P9 = 6000,
+    .dig_H1 = 75, .dig_H2 = 362, .dig_H3 = 0, .dig_H4 = 313, .dig_H5 = 50, .dig_H6 = 30
+};
+
+static const uint8_t bme280_sim_oversampling[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+static const uint8_t bme280_sim_filter[8] = {1, 2, 4, 8, 16, 16, 16, 16};
+static const uint32_t bme280_sim_standby_usec[8] = {500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
+
+static bme280_sim_t *bme280_sim_devices[BME280_SIM_MAX_DEVICES];
+static uint8_t bme280_sim_device_count = 0;
+static uint64_t bme280_sim_clock_ns = 0;
+static uint32_t bme280_sim_byte_ns = (9*1000000000ULL)/BME280_SIM_DEFAULT_BUS_HZ;
+static uint64_t bme280_sim_noise_seed = 1;
+
+void bme280_sim_clear(void) {
+    bme280_sim_device_count = 0;
+    bme280_sim_clock_ns = 0;
+    bme280_sim_noise_seed = 1;
+    bme280_sim_byte_ns = (9*1000000000ULL)/BME280_SIM_DEFAULT_BUS_HZ;
+}
+
+void bme280_sim_set_bus_speed(uint32_t hz) {
+    //0 makes bus transfers take no time
+    bme280_sim_byte_ns = (hz > 0) ? (9*1000000000ULL)/hz : 0;
+}
+
+uint64_t bme280_sim_now_usec(void) {
+    return bme280_sim_clock_ns/1000;
+}
+
+void bme280_sim_advance_usec(uint64_t usec) {
+    bme280_sim_clock_ns += usec*1000;
+}
+
+//standard normal values, reproducible from bme280_sim_clear() on
+static double bme280_sim_gaussian(void) {
+    double u1, u2;
+
+    bme280_sim_noise_seed = bme280_sim_noise_seed*6364136223846793005ULL + 1442695040888963407ULL;
+    u1 = ((bme280_sim_noise_seed >> 11) + 1.0)/9007199254740993.0;
+    bme280_sim_noise_seed = bme280_sim_noise_seed*6364136223846793005ULL + 1442695040888963407ULL;
+    u2 = (bme280_sim_noise_seed >> 11)/9007199254740992.0;
+    return sqrt(-2*log(u1))*cos(2*M_PI*u2);
+}
+
+void bme280_sim_signal(void *context, uint64_t time_usec, double *temperature, double *pressure, double *humidity) {
+    const bme280_sim_signal_t *signal = context;
+    double phase = 0;
+
+    if (signal->period_usec > 0) {
+        phase = sin(2*M_PI*(double)(time_usec%signal->period_usec)/signal->period_usec);
+    }
+    *temperature = signal->temperature + signal->temperature_amplitude*phase;
+    *pressure = signal->pressure + signal->pressure_amplitude*phase;
+    *humidity = signal->humidity + signal->humidity_amplitude*phase;
+    if (signal->temperature_noise > 0) {
+        *temperature += signal->temperature_noise*bme280_sim_gaussian();
+    }
+    if (signal->pressure_noise > 0) {
+        *pressure += signal->pressure_noise*bme280_sim_gaussian();
+    }
+    if (signal->humidity_noise > 0) {
+        *humidity += signal->humidity_noise*bme280_sim_gaussian();
+    }
+}
+
+//compensation formulas of the datasheet (8.1) in double precision
+static double bme280_sim_temperature(const bme280_sim_t *sim, int32_t adc, double *t_fine) {
+    const struct bme280_calibration_param_t *cal = &sim->calibration;
+    double var1, var2;
+
+    var1 = (adc/16384.0 - cal->dig_T1/1024.0)*cal->dig_T2;
+    var2 = (adc/131072.0 - cal->dig_T1/8192.0)*(adc/131072.0 - cal->dig_T1/8192.0)*cal->dig_T3;
+    *t_fine = var1 + var2;
+    return (var1 + var2)/5120.0;
+}
+
+static double bme280_sim_pressure(const bme280_sim_t *sim, int32_t adc, double t_fine) {
+    const struct bme280_calibration_param_t *cal = &sim->calibration;
+    double var1, var2, p;
+
+    var1 = t_fine/2.0 - 64000.0;
+    var2 = var1*var1*cal->dig_P6/32768.0;
+    var2 = var2 + var1*cal->dig_P5*2.0;
+    var2 = var2/4.0 + cal->dig_P4*65536.0;
+    var1 = (cal->dig_P3*var1*var1/524288.0 + cal->dig_P2*var1)/524288.0;
+    var1 = (1.0 + var1/32768.0)*cal->dig_P1;
+    if (var1 == 0.0) {
+        return 0;
+    }
+    p = 1048576.0 - adc;
+    p = (p - var2/4096.0)*6250.0/var1;
+    var1 = cal->dig_P9*p*p/2147483648.0;
+    var2 = p*cal->dig_P8/32768.0;
+    return p + (var1 + var2 + cal->dig_P7)/16.0;
+}
+
+static double bme280_sim_humidity(const bme280_sim_t *sim, int32_t adc, double t_fine) {
+    const struct bme280_calibration_param_t *cal = &sim->calibration;
+    double h = t_fine - 76800.0;
+
+    h = (adc - (cal->dig_H4*64.0 + cal->dig_H5/16384.0*h))*
+        (cal->dig_H2/65536.0*(1.0 + cal->dig_H6/67108864.0*h*(1.0 + cal->dig_H3/67108864.0*h)));
+    return h*(1.0 - cal->dig_H1*h/524288.0);
+}
+
+//smallest raw value whose compensated value reaches the target, the
+//pressure falls with its raw value, temperature and humidity rise
+static int32_t bme280_sim_invert(const bme280_sim_t *sim, char quantity, double target, double t_fine, int32_t max) {
+    int32_t low = 0, high = max, middle;
+    double value, ignore;
+
+    while (low < high) {
+        middle = low + (high - low)/2;
+        if (quantity == 't') {
+            value = bme280_sim_temperature(sim, middle, &ignore);
+        }
+        else if (quantity == 'p') {
+            value = -bme280_sim_pressure(sim, middle, t_fine);
+        }
+        else {
+            value = bme280_sim_humidity(sim, middle, t_fine);
+        }
+        if (value < ((quantity == 'p') ? -target : target)) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static uint64_t bme280_sim_measurement_ns(const bme280_sim_t *sim, uint8_t ctrl_meas, uint8_t ctrl_hum) {
+    uint8_t osrs_t = bme280_sim_oversampling[BME280_GET_BITSLICE(ctrl_meas, BME280_CTRL_MEAS_REG_OVERSAMP_TEMPERATURE)];
+    uint8_t osrs_p = bme280_sim_oversampling[BME280_GET_BITSLICE(ctrl_meas, BME280_CTRL_MEAS_REG_OVERSAMP_PRESSURE)];
+    uint8_t osrs_h = bme280_sim_oversampling[BME280_GET_BITSLICE(ctrl_hum, BME280_CTRL_HUMIDITY_REG_OVERSAMP_HUMIDITY)];
+    uint64_t init, per_osrs, setup;
+
+    if (sim->timing == BME280_SIM_TIMING_MAXIMUM) {
+        init = BME280_SIM_INIT_NS_MAX;
+        per_osrs = BME280_SIM_PER_OSRS_NS_MAX;
+        setup = BME280_SIM_SETUP_NS_MAX;
+    }
+    else {
+        init = BME280_SIM_INIT_NS_TYP;
+        per_osrs = BME280_SIM_PER_OSRS_NS_TYP;
+        setup = BME280_SIM_SETUP_NS_TYP;
+    }
+    return init + per_osrs*osrs_t + ((osrs_p > 0) ? (per_osrs*osrs_p + setup) : 0) +
+           ((osrs_h > 0) ? (per_osrs*osrs_h + setup) : 0);
+}
+
+static void bme280_sim_start_measurement(bme280_sim_t *sim, uint64_t start_ns) {
+    sim->is_measuring = 1;
+    sim->measurement_ctrl_meas = sim->registers[BME280_CTRL_MEAS_REG];
+    sim->measurement_ctrl_hum = sim->ctrl_hum;
+    sim->measurement_start_ns = start_ns;
+    sim->measurement_end_ns = start_ns + bme280_sim_measurement_ns(sim, sim->measurement_ctrl_meas, sim->measurement_ctrl_hum);
+}
+
+//raw value at the resolution of its oversampling, 16 bit at x1 up to 20 bit at x16
+static int32_t bme280_sim_resolution(int32_t adc, uint8_t osrs_setting) {
+    uint8_t dropped_bits = (osrs_setting < 5) ? (5 - osrs_setting) : 0;
+
+    return adc & ~((1 << dropped_bits) - 1);
+}
+
+static void bme280_sim_finish_measurement(bme280_sim_t *sim) {
+    uint8_t osrs_t = BME280_GET_BITSLICE(sim->measurement_ctrl_meas, BME280_CTRL_MEAS_REG_OVERSAMP_TEMPERATURE);
+    uint8_t osrs_p = BME280_GET_BITSLICE(sim->measurement_ctrl_meas, BME280_CTRL_MEAS_REG_OVERSAMP_PRESSURE);
+    uint8_t osrs_h = BME280_GET_BITSLICE(sim->measurement_ctrl_hum, BME280_CTRL_HUMIDITY_REG_OVERSAMP_HUMIDITY);
+    uint8_t filter = bme280_sim_filter[BME280_GET_BITSLICE(sim->registers[BME280_CONFIG_REG], BME280_CONFIG_REG_FILTER)];
+    int32_t adc_t = BME280_SIM_ADC_SKIPPED, adc_p = BME280_SIM_ADC_SKIPPED, adc_h = BME280_SIM_ADC_HUMIDITY_SKIPPED;
+    double t_fine;
+    uint8_t *data = &sim->registers[BME280_PRESSURE_MSB_REG];
+
+    sim->is_measuring = 0;
+    sim->conversion_ns = sim->measurement_end_ns;
+    sim->conversions++;
+    if (sim->environment != NULL) {
+        (*sim->environment)(sim->environment_context, sim->measurement_end_ns/1000,
+                            &sim->temperature, &sim->pressure, &sim->humidity);
+    }
+    else {
+        sim->temperature = 25;
+        sim->pressure = 100000;
+        sim->humidity = 50;
+    }
+
+    adc_t = bme280_sim_invert(sim, 't', sim->temperature, 0, 0xfffff);
+    bme280_sim_temperature(sim, adc_t, &t_fine);
+
+    //the IIR filter works on the 20 bit temperature and pressure, humidity is not filtered
+    if (osrs_t > 0) {
+        if (filter > 1) {
+            sim->filter_temperature = sim->is_filter_valid ?
+                (sim->filter_temperature*(filter - 1) + adc_t)/filter : adc_t;
+            adc_t = (int32_t)lround(sim->filter_temperature);
+        }
+        else {
+            adc_t = bme280_sim_resolution(adc_t, osrs_t);
+        }
+    }
+    else {
+        adc_t = BME280_SIM_ADC_SKIPPED;
+    }
+    if (osrs_p > 0) {
+        adc_p = bme280_sim_invert(sim, 'p', sim->pressure, t_fine, 0xfffff);
+        if (filter > 1) {
+            sim->filter_pressure = sim->is_filter_valid ?
+                (sim->filter_pressure*(filter - 1) + adc_p)/filter : adc_p;
+            adc_p = (int32_t)lround(sim->filter_pressure);
+        }
+        else {
+            adc_p = bme280_sim_resolution(adc_p, osrs_p);
+        }
+    }
+    if (osrs_h > 0) {
+        adc_h = bme280_sim_invert(sim, 'h', sim->humidity, t_fine, 0xffff);
+    }
+    sim->is_filter_valid = (filter > 1);
+
+    data[0] = (adc_p >> 12) & 0xff;
+    data[1] = (adc_p >> 4) & 0xff;
+    data[2] = (adc_p << 4) & 0xf0;
+    data[3] = (adc_t >> 12) & 0xff;
+    data[4] = (adc_t >> 4) & 0xff;
+    data[5] = (adc_t << 4) & 0xf0;
+    data[6] = (adc_h >> 8) & 0xff;
+    data[7] = adc_h & 0xff;
+}
+
+//brings the device state up to the virtual clock
+static void bme280_sim_update(bme280_sim_t *sim) {
+    uint8_t *ctrl_meas = &sim->registers[BME280_CTRL_MEAS_REG];
+    uint64_t cycle_ns, next_ns, cycles;
+
+    while (sim->is_measuring && (sim->measurement_end_ns <= bme280_sim_clock_ns)) {
+        bme280_sim_finish_measurement(sim);
+
+        if (BME280_GET_BITSLICE(*ctrl_meas, BME280_CTRL_MEAS_REG_POWER_MODE) != BME280_NORMAL_MODE) {
+            //forced mode falls back to sleep
+            *ctrl_meas = BME280_SET_BITSLICE(*ctrl_meas, BME280_CTRL_MEAS_REG_POWER_MODE, BME280_SLEEP_MODE);
+            break;
+        }
+
+        cycle_ns = (sim->measurement_end_ns - sim->measurement_start_ns) +
+                   bme280_sim_standby_usec[BME280_GET_BITSLICE(sim->registers[BME280_CONFIG_REG], BME280_CONFIG_REG_TSB)]*1000ULL;
+        next_ns = sim->measurement_start_ns + cycle_ns;
+        if (next_ns < bme280_sim_clock_ns) {
+            cycles = (bme280_sim_clock_ns - next_ns)/cycle_ns;
+            if (cycles > BME280_SIM_MAX_CATCH_UP_CYCLES) {
+                next_ns += (cycles - BME280_SIM_MAX_CATCH_UP_CYCLES)*cycle_ns;
+            }
+        }
+        bme280_sim_start_measurement(sim, next_ns);
+        if (sim->measurement_start_ns > bme280_sim_clock_ns) {
+            //still in standby, the conversion is only scheduled
+            break;
+        }
+    }
+}
+
+static void bme280_sim_reset(bme280_sim_t *sim) {
+    memset(&sim->registers[BME280_CTRL_HUMIDITY_REG], 0, 4);
+    sim->registers[BME280_PRESSURE_MSB_REG] = 0x80;
+    sim->registers[BME280_PRESSURE_MSB_REG+1] = 0;
+    sim->registers[BME280_PRESSURE_MSB_REG+2] = 0;
+    sim->registers[BME280_TEMPERATURE_MSB_REG] = 0x80;
+    sim->registers[BME280_TEMPERATURE_MSB_REG+1] = 0;
+    sim->registers[BME280_TEMPERATURE_MSB_REG+2] = 0;
+    sim->registers[BME280_HUMIDITY_MSB_REG] = 0x80;
+    sim->registers[BME280_HUMIDITY_MSB_REG+1] = 0;
+    sim->ctrl_hum = 0;
+    sim->is_measuring = 0;
+    sim->is_filter_valid = 0;
+    sim->im_update_end_ns = bme280_sim_clock_ns + BME280_SIM_STARTUP_USEC*1000ULL;
+}
+
+static void bme280_sim_write_register(bme280_sim_t *sim, uint8_t register_address, uint8_t value) {
+    uint8_t mode;
+
+    switch (register_address) {
+        case BME280_RST_REG:
+            if (value == BME280_SOFT_RESET_CODE) {
+                bme280_sim_reset(sim);
+            }
+            break;
+        case BME280_CTRL_HUMIDITY_REG:
+            //takes effect with the next ctrl_meas write
+            sim->registers[register_address] = value & 0x07;
+            break;
+        case BME280_CTRL_MEAS_REG:
+            sim->registers[register_address] = value;
+            sim->ctrl_hum = sim->registers[BME280_CTRL_HUMIDITY_REG];
+            mode = BME280_GET_BITSLICE(value, BME280_CTRL_MEAS_REG_POWER_MODE);
+            if (mode == BME280_SLEEP_MODE) {
+                //a running forced conversion still completes
+                if (sim->is_measuring && (sim->measurement_start_ns > bme280_sim_clock_ns)) {
+                    sim->is_measuring = 0;
+                }
+            }
+            else if (!sim->is_measuring || (sim->measurement_start_ns > bme280_sim_clock_ns)) {
+                bme280_sim_start_measurement(sim, bme280_sim_clock_ns);
+            }
+            break;
+        case BME280_CONFIG_REG:
+            //writes in normal mode are ignored
+            if (BME280_GET_BITSLICE(sim->registers[BME280_CTRL_MEAS_REG], BME280_CTRL_MEAS_REG_POWER_MODE) != BME280_NORMAL_MODE) {
+                sim->registers[register_address] = value & 0xfd;
+            }
+            break;
+        default:
+            //calibration, id, status and data registers are read only
+            break;
+    }
+}
+
+static bme280_sim_t *bme280_sim_find(uint8_t device_address) {
+    uint8_t i;
+
+    for (i = 0; i < bme280_sim_device_count; i++) {
+        if (bme280_sim_devices[i]->address == device_address) {
+            return bme280_sim_devices[i];
+        }
+    }
+    return NULL;
+}
+
+int bme280_sim_init(bme280_sim_t *sim, uint8_t address, const struct bme280_calibration_param_t *calibration) {
+    const struct bme280_calibration_param_t *cal = (calibration != NULL) ? calibration : &bme280_sim_default_calibration;
+    uint8_t *calib = &sim->registers[BME280_TEMPERATURE_CALIB_DIG_T1_LSB_REG];
+    uint8_t *calib_h = &sim->registers[BME280_HUMIDITY_CALIB_DIG_H2_LSB_REG];
+    const int32_t words[12] = {
+        cal->dig_T1, cal->dig_T2, cal->dig_T3,
+        cal->dig_P1, cal->dig_P2, cal->dig_P3, cal->dig_P4, cal->dig_P5,
+        cal->dig_P6, cal->dig_P7, cal->dig_P8, cal->dig_P9
+    };
+    uint8_t i;
+
+    if ((bme280_sim_device_count >= BME280_SIM_MAX_DEVICES) || (bme280_sim_find(address) != NULL)) {
+        return -1;
+    }
+
+    memset(sim, 0, sizeof(*sim));
+    sim->address = address;
+    sim->calibration = *cal;
+    sim->calibration.t_fine = 0;
+
+    sim->registers[BME280_CHIP_ID_REG] = BME280_CHIP_ID;
+    for (i = 0; i < 12; i++) {
+        calib[2*i] = words[i] & 0xff;
+        calib[2*i+1] = (words[i] >> 8) & 0xff;
+    }
+    calib[25] = cal->dig_H1;
+    calib_h[0] = cal->dig_H2 & 0xff;
+    calib_h[1] = (cal->dig_H2 >> 8) & 0xff;
+    calib_h[2] = cal->dig_H3;
+    calib_h[3] = (cal->dig_H4 >> 4) & 0xff;
+    calib_h[4] = (cal->dig_H4 & 0x0f) | ((cal->dig_H5 & 0x0f) << 4);
+    calib_h[5] = (cal->dig_H5 >> 4) & 0xff;
+    calib_h[6] = cal->dig_H6;
+
+    bme280_sim_reset(sim);
+    //powered up long ago, the NVM copy is done
+    sim->im_update_end_ns = 0;
+
+    bme280_sim_devices[bme280_sim_device_count++] = sim;
+    return 0;
+}
+
+void bme280_sim_attach(struct bme280_t *bme280, bme280_sim_t *sim) {
+    memset(bme280, 0, sizeof(*bme280));
+    bme280->bus_write = bme280_sim_bus_write;
+    bme280->bus_read = bme280_sim_bus_read;
+    bme280->dev_addr = sim->address;
+    bme280->delay_msec = bme280_sim_delay;
+    bme280->delay_usec = bme280_sim_delay_usec;
+    bme280->now_usec = bme280_sim_clock_usec;
+}
+
+int8_t bme280_sim_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    bme280_sim_t *sim = bme280_sim_find(device_address);
+    uint8_t *status;
+
+    //address write, register, address read
+    bme280_sim_clock_ns += (3 + length)*(uint64_t)bme280_sim_byte_ns;
+    if ((sim == NULL) || ((register_address + length) > sizeof(sim->registers))) {
+        return (int8_t)ERROR;
+    }
+
+    bme280_sim_update(sim);
+    status = &sim->registers[BME280_STAT_REG];
+    *status = 0;
+    if (sim->is_measuring && (sim->measurement_start_ns <= bme280_sim_clock_ns)) {
+        *status = BME280_SET_BITSLICE(*status, BME280_STAT_REG_MEASURING, 1);
+    }
+    if (bme280_sim_clock_ns < sim->im_update_end_ns) {
+        *status = BME280_SET_BITSLICE(*status, BME280_STAT_REG_IM_UPDATE, 1);
+    }
+    memcpy(data, &sim->registers[register_address], length);
+
+    sim->bus_reads++;
+    sim->bus_bytes += 3 + length;
+    return (int8_t)SUCCESS;
+}
+
+int8_t bme280_sim_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    bme280_sim_t *sim = bme280_sim_find(device_address);
+    uint8_t i;
+
+    bme280_sim_clock_ns += (2 + length)*(uint64_t)bme280_sim_byte_ns;
+    if (sim == NULL) {
+        return (int8_t)ERROR;
+    }
+
+    bme280_sim_update(sim);
+    //a burst write is register/value pairs after the first register
+    bme280_sim_write_register(sim, register_address, data[0]);
+    for (i = 1; (i + 1) < length; i += 2) {
+        bme280_sim_write_register(sim, data[i], data[i+1]);
+    }
+
+    sim->bus_writes++;
+    sim->bus_bytes += 2 + length;
+    return (int8_t)SUCCESS;
+}
+
+void bme280_sim_delay(uint32_t delay) {
+    bme280_sim_clock_ns += delay*1000000ULL;
+}
+
+void bme280_sim_delay_usec(uint32_t delay) {
+    bme280_sim_clock_ns += delay*1000ULL;
+}
+
+uint32_t bme280_sim_clock_usec(void) {
+    return (uint32_t)bme280_sim_now_usec();
+}
@@ -0,0 +1,101 @@
+/*
+ * File:   bme280_sim.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Software BME280 for Linux hosts. Simulated sensors sit on a virtual
+ * bus behind the bus_read/bus_write callbacks of struct bme280_t and
+ * follow the register map of bme280.h: calibration and chip id
+ * registers, ctrl_hum latched by a ctrl_meas write, sleep/forced/normal
+ * modes, status bits, standby times, the IIR filter and the resolution
+ * set by oversampling. Time is virtual and only moves forward through
+ * the delay callbacks and the bus transfer time, so the driver runs as
+ * fast as the host allows.
+ *
+ * Raw values are produced by inverting the datasheet compensation
+ * formulas for the physical values returned by an environment callback
+ * at the end of each conversion.
+ */
+
+#ifndef BME280_SIM_H
+#define BME280_SIM_H
+
+#include <stdint.h>
+
+#include "bme280.h"
+
+#define BME280_SIM_MAX_DEVICES 8
+#define BME280_SIM_STARTUP_USEC 2000
+//400 kHz, 9 clocks per byte
+#define BME280_SIM_DEFAULT_BUS_HZ 400000
+
+typedef enum {
+    BME280_SIM_TIMING_TYPICAL = 0,
+    BME280_SIM_TIMING_MAXIMUM
+} bme280_sim_timing_t;
+
+//physical values at a virtual time: DegC, Pa and %rH
+typedef void (*bme280_sim_environment_t)(void *context, uint64_t time_usec,
+                                         double *temperature, double *pressure, double *humidity);
+
+//mean values with a sine of the given amplitude, period 0 means constant,
+//plus gaussian noise of the given RMS on every conversion
+typedef struct {
+    double temperature;
+    double pressure;
+    double humidity;
+    double temperature_amplitude;
+    double pressure_amplitude;
+    double humidity_amplitude;
+    uint64_t period_usec;
+    double temperature_noise;
+    double pressure_noise;
+    double humidity_noise;
+} bme280_sim_signal_t;
+
+typedef struct {
+    uint8_t address;
+    uint8_t registers[256];
+    struct bme280_calibration_param_t calibration;
+    bme280_sim_timing_t timing;
+    bme280_sim_environment_t environment;   //NULL gives 25 DegC, 1000 hPa, 50 %rH
+    void *environment_context;
+
+    uint8_t ctrl_hum;                       //active humidity setting, latched by ctrl_meas
+    uint8_t is_measuring;
+    uint8_t measurement_ctrl_meas;          //settings of the running conversion
+    uint8_t measurement_ctrl_hum;
+    uint64_t measurement_start_ns;
+    uint64_t measurement_end_ns;
+    uint64_t im_update_end_ns;
+    uint8_t is_filter_valid;
+    double filter_temperature;
+    double filter_pressure;
+
+    //environment of the last conversion
+    double temperature;
+    double pressure;
+    double humidity;
+    uint64_t conversion_ns;
+
+    uint32_t conversions;
+    uint32_t bus_reads;
+    uint32_t bus_writes;
+    uint32_t bus_bytes;
+} bme280_sim_t;
+
+void bme280_sim_clear(void);
+void bme280_sim_set_bus_speed(uint32_t hz);
+uint64_t bme280_sim_now_usec(void);
+void bme280_sim_advance_usec(uint64_t usec);
+
+int bme280_sim_init(bme280_sim_t *sim, uint8_t address, const struct bme280_calibration_param_t *calibration);
+void bme280_sim_attach(struct bme280_t *bme280, bme280_sim_t *sim);
+void bme280_sim_signal(void *context, uint64_t time_usec, double *temperature, double *pressure, double *humidity);
+
+int8_t bme280_sim_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length);
+int8_t bme280_sim_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length);
+void bme280_sim_delay(uint32_t delay);
+void bme280_sim_delay_usec(uint32_t delay);
+uint32_t bme280_sim_clock_usec(void);
+
+#endif /* BME280_SIM_H */
@@ -0,0 +1,83 @@
+/*
+ * File:   bme280_stub.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Stub bus and delay callbacks for running the bme280 component on a
+ * Linux host.
+ */
+
+#include <string.h>
+
+#include "bme280_stub.h"
+
+//calibration example of the BME280 datasheet, dig_T1..dig_P9 and dig_H1
+static const uint8_t bme280_stub_calib_00[] = {
+    0x70, 0x6b, 0x43, 0x67, 0x18, 0xfc,
+    0x7d, 0x8e, 0x43, 0xd6, 0xd0, 0x0b, 0x27, 0x0b, 0x8c, 0x00,
+    0xf9, 0xff, 0x8c, 0x3c, 0xf8, 0xc6, 0x70, 0x17,
+    0x00, 0x4b
+};
+
+//dig_H2..dig_H6: 362, 0, 313, 50, 30
+static const uint8_t bme280_stub_calib_26[] = {
+    0x6a, 0x01, 0x00, 0x13, 0x29, 0x03, 0x1e
+};
+
+static uint8_t bme280_stub_registers[256];
+
+void bme280_stub_reset(void) {
+    memset(bme280_stub_registers, 0, sizeof(bme280_stub_registers));
+
+    bme280_stub_registers[BME280_CHIP_ID_REG] = BME280_CHIP_ID;
+    memcpy(&bme280_stub_registers[BME280_TEMPERATURE_CALIB_DIG_T1_LSB_REG],
+           bme280_stub_calib_00, sizeof(bme280_stub_calib_00));
+    memcpy(&bme280_stub_registers[BME280_HUMIDITY_CALIB_DIG_H2_LSB_REG],
+           bme280_stub_calib_26, sizeof(bme280_stub_calib_26));
+
+    bme280_stub_registers[BME280_PRESSURE_MSB_REG] = (BME280_STUB_UNCOMP_PRESSURE >> 12) & 0xff;
+    bme280_stub_registers[BME280_PRESSURE_LSB_REG] = (BME280_STUB_UNCOMP_PRESSURE >> 4) & 0xff;
+    bme280_stub_registers[BME280_PRESSURE_XLSB_REG] = (BME280_STUB_UNCOMP_PRESSURE << 4) & 0xf0;
+    bme280_stub_registers[BME280_TEMPERATURE_MSB_REG] = (BME280_STUB_UNCOMP_TEMPERATURE >> 12) & 0xff;
+    bme280_stub_registers[BME280_TEMPERATURE_LSB_REG] = (BME280_STUB_UNCOMP_TEMPERATURE >> 4) & 0xff;
+    bme280_stub_registers[BME280_TEMPERATURE_XLSB_REG] = (BME280_STUB_UNCOMP_TEMPERATURE << 4) & 0xf0;
+    bme280_stub_registers[BME280_HUMIDITY_MSB_REG] = (BME280_STUB_UNCOMP_HUMIDITY >> 8) & 0xff;
+    bme280_stub_registers[BME280_HUMIDITY_LSB_REG] = BME280_STUB_UNCOMP_HUMIDITY & 0xff;
+}
+
+void bme280_stub_attach(struct bme280_t *bme280, uint8_t device_address) {
+    memset(bme280, 0, sizeof(*bme280));
+    bme280->bus_write = bme280_stub_bus_write;
+    bme280->bus_read = bme280_stub_bus_read;
+    bme280->dev_addr = device_address;
+    bme280->delay_msec = bme280_stub_delay;
+    bme280->delay_usec = bme280_stub_delay_usec;
+}
+
+int8_t bme280_stub_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    (void)device_address;
+    if ((register_address + length) > sizeof(bme280_stub_registers)) {
+        return (int8_t)ERROR;
+    }
+    memcpy(data, &bme280_stub_registers[register_address], length);
+    return (int8_t)SUCCESS;
+}
+
+int8_t bme280_stub_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    uint8_t i;
+
+    (void)device_address;
+    //a burst write is register/value pairs after the first register
+    bme280_stub_registers[register_address] = data[0];
+    for (i = 1; (i + 1) < length; i += 2) {
+        bme280_stub_registers[data[i]] = data[i+1];
+    }
+    return (int8_t)SUCCESS;
+}
+
+void bme280_stub_delay(uint32_t delay) {
+    (void)delay;
+}
+
+void bme280_stub_delay_usec(uint32_t delay) {
+    (void)delay;
+}
@@ -0,0 +1,30 @@
+/*
+ * File:   bme280_stub.h
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Stub bus and delay callbacks for running the bme280 component on a
+ * Linux host. Reads and writes go to an in-memory register image that
+ * holds the chip id, a fixed calibration set and one data frame.
+ */
+
+#ifndef BME280_STUB_H
+#define BME280_STUB_H
+
+#include <stdint.h>
+
+#include "bme280.h"
+
+//raw data frame of the register image, about 25 DegC, 1006 hPa, 50 %rH
+#define BME280_STUB_UNCOMP_TEMPERATURE 519888
+#define BME280_STUB_UNCOMP_PRESSURE 415148
+#define BME280_STUB_UNCOMP_HUMIDITY 30000
+
+void bme280_stub_reset(void);
+void bme280_stub_attach(struct bme280_t *bme280, uint8_t device_address);
+
+int8_t bme280_stub_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length);
+int8_t bme280_stub_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length);
+void bme280_stub_delay(uint32_t delay);
+void bme280_stub_delay_usec(uint32_t delay);
+
+#endif /* BME280_STUB_H */
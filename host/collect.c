@@ -0,0 +1,152 @@
+/*
+ * File:   collect.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Host collector: receives the datagrams of the nodes on a UDP port and
+ * prints one CSV line per decoded sample or window summary. Datagrams of
+ * records, delta coded series and summaries are told apart by their
+ * version byte, datagrams of the JSON debug mode are printed as they are.
+ * A CSV header is printed whenever the kind of line changes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "telemetry_delta.h"
+#include "telemetry_wire.h"
+
+#define COLLECT_DEFAULT_PORT 16901
+#define COLLECT_DATAGRAM_MAX_LENGTH 1500
+
+static uint8_t collect_header = 0;
+
+static void collect_print(const telemetry_wire_record_t *record) {
+    if (collect_header != TELEMETRY_WIRE_VERSION) {
+        printf("node,sensor,sequence,timestamp_usec,temperature,pressure,humidity\n");
+        collect_header = TELEMETRY_WIRE_VERSION;
+    }
+    printf("%u,0x%02x,%u,%llu,%.2f,%u,%.3f\n", record->node_id, record->sample.sensor, record->sample.sequence,
+           (unsigned long long)record->sample.timestamp_usec, record->sample.temperature/100.0,
+           record->sample.pressure, record->sample.humidity/1024.0);
+}
+
+static void collect_print_summary(uint16_t node_id, const telemetry_summary_t *summary) {
+    const telemetry_stats_t *t = &summary->temperature, *p = &summary->pressure, *h = &summary->humidity;
+
+    if (collect_header != TELEMETRY_WIRE_SUMMARY_VERSION) {
+        printf("node,sensor,sequence,start_usec,length_usec,count,"
+               "temperature_min,temperature_max,temperature_mean,temperature_stddev,"
+               "pressure_min,pressure_max,pressure_mean,pressure_stddev,"
+               "humidity_min,humidity_max,humidity_mean,humidity_stddev\n");
+        collect_header = TELEMETRY_WIRE_SUMMARY_VERSION;
+    }
+    printf("%u,0x%02x,%u,%llu,%u,%u,%.2f,%.2f,%.3f,%.3f,%.0f,%.0f,%.2f,%.2f,%.3f,%.3f,%.4f,%.4f\n",
+           node_id, summary->sensor, summary->sequence, (unsigned long long)summary->start_usec,
+           summary->length_usec, t->count,
+           t->min/100.0, t->max/100.0, t->mean/100.0, telemetry_stats_stddev(t)/100.0,
+           p->min, p->max, p->mean, telemetry_stats_stddev(p),
+           h->min/1024.0, h->max/1024.0, h->mean/1024.0, telemetry_stats_stddev(h)/1024.0);
+}
+
+static void collect_series(const uint8_t *data, size_t length) {
+    telemetry_delta_decoder_t decoder;
+    telemetry_wire_record_t record;
+    int result;
+
+    if (telemetry_delta_decoder_init(&decoder, data, length) != 0) {
+        fprintf(stderr, "undecodable series of %zu bytes\n", length);
+        return;
+    }
+    while ((result = telemetry_delta_next(&decoder, &record)) > 0) {
+        collect_print(&record);
+    }
+    if (result < 0) {
+        fprintf(stderr, "corrupt series at %zu of %zu bytes\n", decoder.offset, length);
+    }
+}
+
+static void collect_datagram(const uint8_t *data, size_t length) {
+    telemetry_wire_record_t record;
+    telemetry_summary_t summary;
+    uint16_t node_id;
+    size_t offset = 0, used;
+
+    if ((length > 0) && (data[0] == '{')) {
+        printf("%.*s\n", (int)length, (const char *)data);
+        return;
+    }
+    if ((length > 0) && (data[0] == TELEMETRY_DELTA_VERSION)) {
+        collect_series(data, length);
+        return;
+    }
+
+    while (offset < length) {
+        if (data[offset] == TELEMETRY_WIRE_SUMMARY_VERSION) {
+            used = telemetry_wire_decode_summary(&data[offset], length - offset, &node_id, &summary);
+            if (used > 0) {
+                collect_print_summary(node_id, &summary);
+            }
+        }
+        else {
+            used = telemetry_wire_decode(&data[offset], length - offset, &record);
+            if (used > 0) {
+                collect_print(&record);
+            }
+        }
+        if (used == 0) {
+            fprintf(stderr, "undecodable record at %zu of %zu bytes, version %u\n", offset, length, data[offset]);
+            return;
+        }
+        offset += used;
+    }
+}
+
+int main(int argc, char **argv) {
+    struct sockaddr_in address;
+    uint8_t data[COLLECT_DATAGRAM_MAX_LENGTH];
+    int port = COLLECT_DEFAULT_PORT;
+    int fd, enable = 1;
+    ssize_t length;
+
+    if (argc > 1) {
+        port = atoi(argv[1]);
+        if ((port <= 0) || (port > 65535)) {
+            fprintf(stderr, "usage: %s [port]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return 1;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        perror("bind");
+        close(fd);
+        return 1;
+    }
+
+    while (1) {
+        length = recv(fd, data, sizeof(data), 0);
+        if (length < 0) {
+            perror("recv");
+            break;
+        }
+        collect_datagram(data, length);
+        fflush(stdout);
+    }
+
+    close(fd);
+    return 1;
+}
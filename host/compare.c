@@ -0,0 +1,154 @@
+/*
+ * File:   compare.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Checks the single precision compensation against the double precision
+ * one on recorded raw frames. The register dumps of frames.txt are served
+ * to the driver by a register map bus, every frame is compensated in
+ * float and in double, and the largest deviations are compared with the
+ * bounds below, well under the resolution of the sensor.
+ *
+ *   bme280_compare [frames]
+ *
+ * Exits with 1 when a deviation is out of bounds or the file can't be read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "bme280.h"
+
+#define COMPARE_DEFAULT_FRAMES "frames.txt"
+#define COMPARE_LINE_MAX_LENGTH 256
+#define COMPARE_CALIB_LENGTH 26
+#define COMPARE_CALIB_H_LENGTH 7
+#define COMPARE_FRAME_LENGTH 8
+
+//resolution at x1 oversampling: 0.005 DegC, 2.6 Pa, 0.008 %rH
+#define COMPARE_MAX_TEMPERATURE 0.001
+#define COMPARE_MAX_PRESSURE 0.1
+#define COMPARE_MAX_HUMIDITY 0.001
+
+static uint8_t compare_registers[256];
+
+static int8_t compare_bus_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    (void)device_address;
+    if ((register_address + length) > sizeof(compare_registers)) {
+        return (int8_t)ERROR;
+    }
+    memcpy(data, &compare_registers[register_address], length);
+    return (int8_t)SUCCESS;
+}
+
+static int8_t compare_bus_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t length) {
+    (void)device_address;
+    if ((register_address + length) > sizeof(compare_registers)) {
+        return (int8_t)ERROR;
+    }
+    memcpy(&compare_registers[register_address], data, length);
+    return (int8_t)SUCCESS;
+}
+
+static void compare_delay(uint32_t delay) {
+    (void)delay;
+}
+
+//reads up to size hex bytes after the keyword, returns how many
+static size_t compare_parse(const char *line, uint8_t *data, size_t size) {
+    char *end;
+    size_t count = 0;
+    unsigned long value;
+
+    line = strchr(line, ' ');
+    while ((line != NULL) && (count < size)) {
+        value = strtoul(line, &end, 16);
+        if ((end == line) || (value > 0xff)) {
+            break;
+        }
+        data[count++] = value;
+        line = end;
+    }
+    return count;
+}
+
+int main(int argc, char **argv) {
+    const char *path = (argc > 1) ? argv[1] : COMPARE_DEFAULT_FRAMES;
+    struct bme280_t device;
+    char line[COMPARE_LINE_MAX_LENGTH];
+    uint8_t calib[COMPARE_CALIB_LENGTH + COMPARE_CALIB_H_LENGTH];
+    double max_temperature = 0, max_pressure = 0, max_humidity = 0;
+    double temperature, pressure, humidity;
+    s32 uncomp_pressure, uncomp_temperature, uncomp_humidity;
+    uint32_t frames = 0, calibrations = 0, number = 0;
+    uint8_t is_calibrated = 0;
+    FILE *file;
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    memset(&device, 0, sizeof(device));
+    device.bus_read = compare_bus_read;
+    device.bus_write = compare_bus_write;
+    device.dev_addr = BME280_I2C_ADDRESS1;
+    device.delay_msec = compare_delay;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        number++;
+        if (strncmp(line, "calib ", 6) == 0) {
+            if (compare_parse(line, calib, sizeof(calib)) != sizeof(calib)) {
+                fprintf(stderr, "%s:%u: bad calibration\n", path, number);
+                fclose(file);
+                return 1;
+            }
+            memset(compare_registers, 0, sizeof(compare_registers));
+            compare_registers[BME280_CHIP_ID_REG] = BME280_CHIP_ID;
+            memcpy(&compare_registers[BME280_TEMPERATURE_CALIB_DIG_T1_LSB_REG], calib, COMPARE_CALIB_LENGTH);
+            memcpy(&compare_registers[BME280_HUMIDITY_CALIB_DIG_H2_LSB_REG], &calib[COMPARE_CALIB_LENGTH],
+                   COMPARE_CALIB_H_LENGTH);
+            if (bme280_init(&device) != SUCCESS) {
+                fprintf(stderr, "%s:%u: init failed\n", path, number);
+                fclose(file);
+                return 1;
+            }
+            is_calibrated = 1;
+            calibrations++;
+        }
+        else if (strncmp(line, "frame ", 6) == 0) {
+            if (!is_calibrated ||
+                (compare_parse(line, &compare_registers[BME280_PRESSURE_MSB_REG], COMPARE_FRAME_LENGTH) != COMPARE_FRAME_LENGTH) ||
+                (bme280_read_uncomp_pressure_temperature_humidity(&device, &uncomp_pressure, &uncomp_temperature,
+                                                                  &uncomp_humidity) != SUCCESS)) {
+                fprintf(stderr, "%s:%u: bad frame\n", path, number);
+                fclose(file);
+                return 1;
+            }
+            //temperature first, it sets t_fine for the other two
+            temperature = bme280_compensate_temperature_double(&device, uncomp_temperature);
+            pressure = bme280_compensate_pressure_double(&device, uncomp_pressure);
+            humidity = bme280_compensate_humidity_double(&device, uncomp_humidity);
+            max_temperature = fmax(max_temperature,
+                                   fabs(bme280_compensate_temperature_float(&device, uncomp_temperature) - temperature));
+            max_pressure = fmax(max_pressure, fabs(bme280_compensate_pressure_float(&device, uncomp_pressure) - pressure));
+            max_humidity = fmax(max_humidity, fabs(bme280_compensate_humidity_float(&device, uncomp_humidity) - humidity));
+            frames++;
+        }
+    }
+    fclose(file);
+
+    printf("%u frames of %u calibrations, float against double\n", frames, calibrations);
+    printf("max deviation: %.6f DegC (bound %.3f), %.4f Pa (bound %.1f), %.6f %%rH (bound %.3f)\n",
+           max_temperature, COMPARE_MAX_TEMPERATURE, max_pressure, COMPARE_MAX_PRESSURE,
+           max_humidity, COMPARE_MAX_HUMIDITY);
+
+    if ((frames == 0) || (max_temperature > COMPARE_MAX_TEMPERATURE) || (max_pressure > COMPARE_MAX_PRESSURE) ||
+        (max_humidity > COMPARE_MAX_HUMIDITY)) {
+        printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
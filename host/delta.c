@@ -0,0 +1,223 @@
+/*
+ * File:   delta.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Round trip check of the delta coded series of telemetry_delta.h. Series
+ * of samples are encoded and decoded again and every decoded sample must
+ * equal the one that went in:
+ *
+ *   - random walks of up to 8 interleaved sensors
+ *   - sequence and timestamp wrapping around, values at the ends of their
+ *     ranges and jumps between them
+ *   - a 9th sensor, which is refused while the series stays decodable
+ *   - a full buffer, which refuses the sample that doesn't fit
+ *
+ *   bme280_delta
+ *
+ * Exits with 1 on the first mismatch.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "telemetry_delta.h"
+
+#define DELTA_NODE_ID 0x0280
+#define DELTA_BUFFER_SIZE 1472
+#define DELTA_RANDOM_SERIES 1000
+
+static uint32_t delta_seed = 1;
+static uint32_t delta_failures = 0;
+
+static uint32_t delta_random(void) {
+    delta_seed = delta_seed*1664525 + 1013904223;
+    return delta_seed;
+}
+
+static void delta_fail(const char *test, const char *reason, uint32_t index) {
+    printf("%s: %s at sample %u\n", test, reason, index);
+    delta_failures++;
+}
+
+//decodes the series and compares it with the samples that were appended
+static void delta_check(const char *test, const uint8_t *buffer, size_t length,
+                        const telemetry_sample_t *samples, uint32_t count) {
+    telemetry_delta_decoder_t decoder;
+    telemetry_wire_record_t record;
+    uint32_t i = 0;
+    int result;
+
+    if (telemetry_delta_decoder_init(&decoder, buffer, length) != 0) {
+        delta_fail(test, "undecodable header", 0);
+        return;
+    }
+    while ((result = telemetry_delta_next(&decoder, &record)) > 0) {
+        if (i >= count) {
+            delta_fail(test, "extra sample", i);
+            return;
+        }
+        if ((record.node_id != DELTA_NODE_ID) || (record.sample.sensor != samples[i].sensor) ||
+            (record.sample.sequence != samples[i].sequence) ||
+            (record.sample.timestamp_usec != samples[i].timestamp_usec) ||
+            (record.sample.temperature != samples[i].temperature) ||
+            (record.sample.pressure != samples[i].pressure) || (record.sample.humidity != samples[i].humidity)) {
+            delta_fail(test, "mismatch", i);
+            return;
+        }
+        i++;
+    }
+    if (result < 0) {
+        delta_fail(test, "corrupt series", i);
+    }
+    else if (i != count) {
+        delta_fail(test, "missing samples", i);
+    }
+}
+
+//appends until the buffer is full, returns the number of samples appended
+static uint32_t delta_encode(telemetry_delta_encoder_t *encoder, uint8_t *buffer, size_t size,
+                             const telemetry_sample_t *samples, uint32_t count) {
+    uint32_t i;
+
+    telemetry_delta_begin(encoder, DELTA_NODE_ID, buffer, size);
+    for (i = 0; i < count; i++) {
+        if (telemetry_delta_append(encoder, &samples[i]) == 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+static void delta_test_random(void) {
+    static telemetry_sample_t samples[DELTA_BUFFER_SIZE];
+    static uint8_t buffer[DELTA_BUFFER_SIZE];
+    telemetry_delta_encoder_t encoder;
+    telemetry_sample_t last[TELEMETRY_DELTA_MAX_SENSORS];
+    uint32_t series, i, count, appended;
+    uint8_t sensors, sensor;
+
+    for (series = 0; series < DELTA_RANDOM_SERIES; series++) {
+        sensors = 1 + delta_random()%TELEMETRY_DELTA_MAX_SENSORS;
+        for (i = 0; i < sensors; i++) {
+            last[i].sequence = delta_random();
+            last[i].timestamp_usec = ((uint64_t)delta_random() << 32) | delta_random();
+            last[i].temperature = (int32_t)(delta_random()%12500) - 4000;
+            last[i].pressure = 30000 + delta_random()%80000;
+            last[i].humidity = delta_random()%102401;
+            last[i].sensor = 0x40 + i;
+        }
+        count = 1 + delta_random()%(DELTA_BUFFER_SIZE/2);
+        for (i = 0; i < count; i++) {
+            sensor = delta_random()%sensors;
+            last[sensor].sequence += 1 + delta_random()%3;
+            last[sensor].timestamp_usec += 9000 + delta_random()%2000;
+            last[sensor].temperature += (int32_t)(delta_random()%21) - 10;
+            last[sensor].pressure += (int32_t)(delta_random()%201) - 100;
+            last[sensor].humidity += (int32_t)(delta_random()%41) - 20;
+            samples[i] = last[sensor];
+        }
+        appended = delta_encode(&encoder, buffer, sizeof(buffer), samples, count);
+        delta_check("random", buffer, encoder.length, samples, appended);
+    }
+}
+
+static void delta_test_wrap(void) {
+    static const telemetry_sample_t samples[] = {
+        {.timestamp_usec = UINT64_MAX - 1, .sequence = UINT32_MAX - 1, .temperature = INT32_MAX,
+         .pressure = UINT32_MAX, .humidity = UINT32_MAX, .sensor = 0x76},
+        {.timestamp_usec = UINT64_MAX, .sequence = UINT32_MAX, .temperature = INT32_MIN,
+         .pressure = 0, .humidity = 0, .sensor = 0x76},
+        //sequence and timestamp wrap around
+        {.timestamp_usec = 0, .sequence = 0, .temperature = INT32_MAX,
+         .pressure = UINT32_MAX, .humidity = UINT32_MAX, .sensor = 0x76},
+        {.timestamp_usec = 1, .sequence = 1, .temperature = 0, .pressure = 1, .humidity = 1, .sensor = 0x76},
+        //time going backwards, e.g. after the clock was set
+        {.timestamp_usec = 0x8000000000000000ULL, .sequence = 0x80000000, .temperature = -1,
+         .pressure = 0x80000000, .humidity = 0x80000000, .sensor = 0x76},
+        {.timestamp_usec = 5, .sequence = 2, .temperature = 2500, .pressure = 100000, .humidity = 51200, .sensor = 0x76},
+        //a second sensor starts from zero in the same series
+        {.timestamp_usec = UINT64_MAX, .sequence = UINT32_MAX, .temperature = INT32_MIN,
+         .pressure = UINT32_MAX, .humidity = UINT32_MAX, .sensor = 0x77},
+        {.timestamp_usec = 3, .sequence = 0, .temperature = INT32_MAX, .pressure = 0, .humidity = 0, .sensor = 0x77},
+    };
+    uint8_t buffer[sizeof(samples)/sizeof(samples[0])*TELEMETRY_DELTA_SAMPLE_MAX_SIZE + TELEMETRY_DELTA_HEADER_SIZE];
+    telemetry_delta_encoder_t encoder;
+    uint32_t count = sizeof(samples)/sizeof(samples[0]);
+
+    if (delta_encode(&encoder, buffer, sizeof(buffer), samples, count) != count) {
+        delta_fail("wrap", "refused", 0);
+        return;
+    }
+    delta_check("wrap", buffer, encoder.length, samples, count);
+}
+
+static void delta_test_sensor_limit(void) {
+    telemetry_sample_t samples[TELEMETRY_DELTA_MAX_SENSORS + 2];
+    uint8_t buffer[DELTA_BUFFER_SIZE];
+    telemetry_delta_encoder_t encoder;
+    telemetry_sample_t extra;
+    uint32_t i;
+
+    memset(samples, 0, sizeof(samples));
+    telemetry_delta_begin(&encoder, DELTA_NODE_ID, buffer, sizeof(buffer));
+    for (i = 0; i < TELEMETRY_DELTA_MAX_SENSORS; i++) {
+        samples[i].sensor = 0x76 + i;
+        samples[i].sequence = i;
+        samples[i].timestamp_usec = 1000*i;
+        if (telemetry_delta_append(&encoder, &samples[i]) == 0) {
+            delta_fail("sensor limit", "refused", i);
+            return;
+        }
+    }
+    extra = samples[0];
+    extra.sensor = 0x76 + TELEMETRY_DELTA_MAX_SENSORS;
+    if (telemetry_delta_append(&encoder, &extra) != 0) {
+        delta_fail("sensor limit", "sensor beyond the limit appended", i);
+        return;
+    }
+    //known sensors go on after the refusal
+    samples[i] = samples[0];
+    samples[i].sequence = TELEMETRY_DELTA_MAX_SENSORS;
+    if (telemetry_delta_append(&encoder, &samples[i]) == 0) {
+        delta_fail("sensor limit", "known sensor refused", i);
+        return;
+    }
+    delta_check("sensor limit", buffer, encoder.length, samples, i + 1);
+}
+
+static void delta_test_full(void) {
+    telemetry_sample_t samples[64];
+    uint8_t buffer[TELEMETRY_DELTA_HEADER_SIZE + 3*TELEMETRY_DELTA_SAMPLE_MAX_SIZE];
+    telemetry_delta_encoder_t encoder;
+    uint32_t i, appended;
+
+    for (i = 0; i < 64; i++) {
+        samples[i].sensor = 0x76;
+        samples[i].sequence = i*0x10000000;
+        samples[i].timestamp_usec = (uint64_t)i << 56;
+        samples[i].temperature = (i & 1) ? INT32_MIN : INT32_MAX;
+        samples[i].pressure = (i & 1) ? 0 : UINT32_MAX;
+        samples[i].humidity = (i & 1) ? UINT32_MAX : 0;
+    }
+    appended = delta_encode(&encoder, buffer, sizeof(buffer), samples, 64);
+    if ((appended == 0) || (appended == 64) || (encoder.length > sizeof(buffer))) {
+        delta_fail("full", "bad refusal", appended);
+        return;
+    }
+    delta_check("full", buffer, encoder.length, samples, appended);
+}
+
+int main(void) {
+    delta_test_random();
+    delta_test_wrap();
+    delta_test_sensor_limit();
+    delta_test_full();
+
+    if (delta_failures > 0) {
+        printf("FAILED, %u failures\n", delta_failures);
+        return 1;
+    }
+    printf("delta series round trip: random, wrap, sensor limit and full buffer passed\n");
+    return 0;
+}
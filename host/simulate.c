@@ -0,0 +1,132 @@
+/*
+ * File:   simulate.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * Runs the driver and the sampler against simulated sensors in forced
+ * mode and reports the virtual cycle latency, the bus traffic, the host
+ * time per cycle and the error of the compensated values against the
+ * environment the simulator converted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "bme280.h"
+#include "bme280_sampler.h"
+#include "bme280_sim.h"
+
+#define SIMULATE_SENSORS 2
+#define SIMULATE_DEFAULT_CYCLES 10000
+
+static const struct bme280_config_t simulate_config = {
+    .oversamp_temperature = BME280_OVERSAMP_2X,
+    .oversamp_pressure = BME280_OVERSAMP_16X,
+    .oversamp_humidity = BME280_OVERSAMP_1X,
+    .power_mode = BME280_SLEEP_MODE,
+    .standby_durn = BME280_STANDBY_TIME_1_MS,
+    .filter = BME280_FILTER_COEFF_OFF
+};
+
+static const bme280_sim_signal_t simulate_signal = {
+    .temperature = 22,
+    .pressure = 100000,
+    .humidity = 45,
+    .temperature_amplitude = 15,
+    .pressure_amplitude = 5000,
+    .humidity_amplitude = 40,
+    .period_usec = 60000000
+};
+
+static double simulate_now_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec*1e9 + now.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    static bme280_sim_t sims[SIMULATE_SENSORS];
+    static struct bme280_t devices[SIMULATE_SENSORS];
+    static struct bme280_sampler_t sampler;
+    struct bme280_compensated_double_t values;
+    uint32_t cycles = SIMULATE_DEFAULT_CYCLES;
+    uint32_t cycle, bytes = 0, failures = 0;
+    uint64_t virtual_start, virtual_cycle, virtual_max = 0;
+    double host_start, host_elapsed;
+    double error_temperature = 0, error_pressure = 0, error_humidity = 0;
+    int32_t result;
+    uint8_t i;
+
+    if (argc > 1) {
+        cycles = strtoul(argv[1], NULL, 10);
+        if (cycles == 0) {
+            fprintf(stderr, "usage: %s [cycles]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    bme280_sim_clear();
+    for (i = 0; i < SIMULATE_SENSORS; i++) {
+        bme280_sim_init(&sims[i], BME280_I2C_ADDRESS1 + i, NULL);
+        sims[i].environment = bme280_sim_signal;
+        sims[i].environment_context = (void *)&simulate_signal;
+        sims[i].timing = (i == 0) ? BME280_SIM_TIMING_TYPICAL : BME280_SIM_TIMING_MAXIMUM;
+
+        bme280_sim_attach(&devices[i], &sims[i]);
+        devices[i].shadow_mode = BME280_SHADOW_MODE_ENABLE;
+        result = bme280_init(&devices[i]);
+        if (result == SUCCESS) {
+            result = bme280_apply_config(&devices[i], &simulate_config, BME280_CONFIG_VERIFY_ENABLE);
+        }
+        if (result != SUCCESS) {
+            fprintf(stderr, "BME280(0x%02x) setup failed: %d\n", devices[i].dev_addr, result);
+            return 1;
+        }
+        bme280_sampler_add(&sampler, &devices[i], NULL, NULL, NULL);
+    }
+
+    host_start = simulate_now_ns();
+    virtual_start = bme280_sim_now_usec();
+    for (cycle = 0; cycle < cycles; cycle++) {
+        virtual_cycle = bme280_sim_now_usec();
+        if (bme280_sampler_run(&sampler) != SUCCESS) {
+            failures++;
+        }
+        virtual_cycle = bme280_sim_now_usec() - virtual_cycle;
+        if (virtual_cycle > virtual_max) {
+            virtual_max = virtual_cycle;
+        }
+
+        for (i = 0; i < sampler.sensor_count; i++) {
+            struct bme280_sampler_sensor_t *sensor = &sampler.sensors[i];
+
+            if (sensor->result != SUCCESS) {
+                continue;
+            }
+            values = bme280_compensate_all_double(sensor->device, sensor->uncomp_pressure,
+                                                  sensor->uncomp_temperature, sensor->uncomp_humidity);
+            error_temperature = fmax(error_temperature, fabs(values.temperature - sims[i].temperature));
+            error_pressure = fmax(error_pressure, fabs(values.pressure - sims[i].pressure));
+            error_humidity = fmax(error_humidity, fabs(values.humidity - sims[i].humidity));
+        }
+        //time between samples
+        bme280_sim_advance_usec(10000);
+    }
+    host_elapsed = simulate_now_ns() - host_start;
+
+    for (i = 0; i < SIMULATE_SENSORS; i++) {
+        bytes += sims[i].bus_bytes;
+    }
+
+    printf("%u cycles of %u sensors, %u failed\n", cycles, SIMULATE_SENSORS, failures);
+    printf("virtual latency per cycle: %.1f us average, %llu us max\n",
+           ((double)(bme280_sim_now_usec() - virtual_start)/cycles) - 10000, (unsigned long long)virtual_max);
+    printf("bus bytes per cycle: %.1f\n", (double)bytes/cycles);
+    printf("host time per cycle: %.0f ns, %.0fx real time\n", host_elapsed/cycles,
+           ((double)(bme280_sim_now_usec() - virtual_start)*1000)/host_elapsed);
+    printf("max error: %.4f DegC, %.3f Pa, %.4f %%rH\n", error_temperature, error_pressure, error_humidity);
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+/*
+ * File:   stream.c
+ * Author: ripx (ALEXANDER BERDNIKOV)
+ *
+ * End to end throughput of the streaming mode on simulated sensors. The
+ * sensors run in normal mode at their maximum output data rate with the
+ * noise of the datasheet, and the sampler polls them faster than their
+ * nominal output period of virtual time, like the esp_timer driven sampler
+ * of the node. Frames read twice are dropped, the others go through the lock-free
+ * queue into delta coded datagrams, which are decoded and checked here
+ * or sent to a collector. The same samples are aggregated into window
+ * summaries, whose wire records are decoded and checked as well.
+ *
+ *   bme280_stream [seconds [host port]]
+ *
+ * Reports the rate of unique samples, repeated frames dropped, how many
+ * of those drops were wrong against the conversion count of the simulated
+ * sensors, conversions missed, the bus
+ * load, datagrams and bytes per sample, the uplink of the summaries
+ * against the delta coded stream, and the host time the pipeline takes
+ * per sample. Fails if a conversion is dropped, missed or sent twice.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "bme280.h"
+#include "bme280_sampler.h"
+#include "bme280_sim.h"
+#include "telemetry_aggregate.h"
+#include "telemetry_batch.h"
+#include "telemetry_delta.h"
+#include "telemetry_queue.h"
+#include "telemetry_wire.h"
+
+#define STREAM_SENSORS 2
+#define STREAM_DEFAULT_SECONDS 60
+#define STREAM_BUS_HZ 1000000
+#define STREAM_QUEUE_LENGTH 512
+#define STREAM_NODE_ID 0x0280
+#define STREAM_WINDOW_USEC 10000000
+//polls at 3/4 of the nominal output period of the fastest sensor, like NODE_STREAM_POLL_PERCENT
+#define STREAM_POLL_PERCENT 75
+
+//the sensor configuration of the streaming mode of the node
+static const struct bme280_config_t stream_config = {
+    .oversamp_temperature = BME280_OVERSAMP_1X,
+    .oversamp_pressure = BME280_OVERSAMP_1X,
+    .oversamp_humidity = BME280_OVERSAMP_1X,
+    .power_mode = BME280_NORMAL_MODE,
+    .standby_durn = BME280_STANDBY_TIME_1_MS,
+    .filter = BME280_FILTER_COEFF_OFF
+};
+
+//air pressure swings of a building, 50 Pa over 10 s, with about the RMS
+//noise of the datasheet at x1 oversampling and the filter off
+static const bme280_sim_signal_t stream_signal = {
+    .temperature = 22,
+    .pressure = 100000,
+    .humidity = 45,
+    .temperature_amplitude = 0.5,
+    .pressure_amplitude = 50,
+    .humidity_amplitude = 2,
+    .period_usec = 10000000,
+    .temperature_noise = 0.005,
+    .pressure_noise = 3.3,
+    .humidity_noise = 0.02
+};
+
+typedef struct {
+    int fd;                     //-1 decodes and checks the datagrams
+    struct sockaddr_in address;
+    uint32_t next_sequence;
+    uint32_t decoded;
+    uint32_t errors;
+    uint64_t bytes;
+} stream_link_t;
+
+typedef struct {
+    uint32_t summaries;
+    uint32_t samples;
+    uint32_t errors;
+    uint64_t bytes;
+} stream_summaries_t;
+
+static uint8_t stream_stats_equal(const telemetry_stats_t *sent, const telemetry_stats_t *received) {
+    double stddev = telemetry_stats_stddev(sent);
+
+    //min and max are integers on the wire, mean and stddev float32
+    return (received->count == sent->count) && (received->min == sent->min) && (received->max == sent->max) &&
+           (fabs(received->mean - sent->mean) <= fabs(sent->mean)*1e-6) &&
+           (fabs(telemetry_stats_stddev(received) - stddev) <= stddev*1e-6 + 1e-9);
+}
+
+//emit callback of the aggregate, checks the wire record of every summary
+static void stream_summary(void *context, const telemetry_summary_t *summary) {
+    stream_summaries_t *summaries = context;
+    uint8_t data[TELEMETRY_WIRE_SUMMARY_SIZE];
+    telemetry_summary_t received;
+    uint16_t node_id;
+    size_t length;
+
+    length = telemetry_wire_encode_summary(summary, STREAM_NODE_ID, data, sizeof(data));
+    if ((telemetry_wire_decode_summary(data, length, &node_id, &received) != length) || (node_id != STREAM_NODE_ID) ||
+        (received.sensor != summary->sensor) || (received.sequence != summaries->summaries) ||
+        (received.start_usec != summary->start_usec) || (received.length_usec != summary->length_usec) ||
+        !stream_stats_equal(&summary->temperature, &received.temperature) ||
+        !stream_stats_equal(&summary->pressure, &received.pressure) ||
+        !stream_stats_equal(&summary->humidity, &received.humidity)) {
+        summaries->errors++;
+    }
+    summaries->summaries++;
+    summaries->samples += summary->temperature.count;
+    summaries->bytes += length;
+}
+
+static double stream_now_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec*1e9 + now.tv_nsec;
+}
+
+static void stream_send(void *context, const uint8_t *data, size_t length) {
+    stream_link_t *link = context;
+    telemetry_delta_decoder_t decoder;
+    telemetry_wire_record_t record;
+    int result;
+
+    link->bytes += length;
+    if (link->fd >= 0) {
+        if (sendto(link->fd, data, length, 0, (struct sockaddr *)&link->address, sizeof(link->address)) < 0) {
+            perror("sendto");
+            link->errors++;
+        }
+        return;
+    }
+
+    if (telemetry_delta_decoder_init(&decoder, data, length) != 0) {
+        link->errors++;
+        return;
+    }
+    while ((result = telemetry_delta_next(&decoder, &record)) > 0) {
+        if ((record.node_id != STREAM_NODE_ID) || (record.sample.sequence != link->next_sequence)) {
+            link->errors++;
+        }
+        link->next_sequence = record.sample.sequence + 1;
+        link->decoded++;
+    }
+    if (result < 0) {
+        link->errors++;
+    }
+}
+
+int main(int argc, char **argv) {
+    static bme280_sim_t sims[STREAM_SENSORS];
+    static struct bme280_t devices[STREAM_SENSORS];
+    static struct bme280_sampler_t sampler;
+    static telemetry_sample_t entries[STREAM_QUEUE_LENGTH];
+    static telemetry_queue_t queue;
+    static telemetry_batch_t batch;
+    static telemetry_aggregate_t aggregate;
+    uint32_t last_conversions[STREAM_SENSORS];
+    stream_link_t link = {.fd = -1};
+    stream_summaries_t summaries = {0};
+    struct bme280_compensated_int32_t values;
+    telemetry_sample_t sample;
+    uint32_t seconds = STREAM_DEFAULT_SECONDS;
+    uint32_t period = 0, poll_period, sensor_period;
+    uint32_t samples = 0, repeated = 0, wrong_drops = 0, undetected = 0, missed = 0, bytes = 0, passes = 0;
+    uint8_t is_new;
+    uint64_t deadline, start, end, now;
+    double host_start, host_elapsed;
+    int32_t result;
+    uint8_t i;
+
+    if (argc > 1) {
+        seconds = strtoul(argv[1], NULL, 10);
+    }
+    if ((seconds == 0) || (argc == 3) || (argc > 4)) {
+        fprintf(stderr, "usage: %s [seconds [host port]]\n", argv[0]);
+        return 1;
+    }
+    if (argc == 4) {
+        link.fd = socket(AF_INET, SOCK_DGRAM, 0);
+        link.address.sin_family = AF_INET;
+        link.address.sin_port = htons(atoi(argv[3]));
+        if ((link.fd < 0) || (inet_pton(AF_INET, argv[2], &link.address.sin_addr) != 1)) {
+            fprintf(stderr, "bad collector address %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    bme280_sim_clear();
+    bme280_sim_set_bus_speed(STREAM_BUS_HZ);
+    for (i = 0; i < STREAM_SENSORS; i++) {
+        bme280_sim_init(&sims[i], BME280_I2C_ADDRESS1 + i, NULL);
+        sims[i].environment = bme280_sim_signal;
+        sims[i].environment_context = (void *)&stream_signal;
+        sims[i].timing = (i == 0) ? BME280_SIM_TIMING_TYPICAL : BME280_SIM_TIMING_MAXIMUM;
+
+        bme280_sim_attach(&devices[i], &sims[i]);
+        devices[i].shadow_mode = BME280_SHADOW_MODE_ENABLE;
+        result = bme280_init(&devices[i]);
+        if (result == SUCCESS) {
+            result = bme280_apply_config(&devices[i], &stream_config, BME280_CONFIG_VERIFY_ENABLE);
+        }
+        if (result != SUCCESS) {
+            fprintf(stderr, "BME280(0x%02x) setup failed: %d\n", devices[i].dev_addr, result);
+            return 1;
+        }
+        bme280_sampler_add(&sampler, &devices[i], NULL, NULL, NULL);
+
+        //polled like the node: faster than the fastest sensor converts
+        bme280_compute_normal_mode_period_usec(&devices[i], &sensor_period);
+        if ((period == 0) || (sensor_period < period)) {
+            period = sensor_period;
+        }
+    }
+
+    telemetry_queue_init(&queue, entries, STREAM_QUEUE_LENGTH, TELEMETRY_QUEUE_DROP_OLDEST);
+    telemetry_batch_init(&batch, STREAM_NODE_ID, TELEMETRY_BATCH_DELTA, 0, 1000000, stream_send, &link);
+    telemetry_aggregate_init(&aggregate, STREAM_WINDOW_USEC, stream_summary, &summaries);
+
+    poll_period = (period*STREAM_POLL_PERCENT)/100;
+    //the first read has no frame to compare with
+    bme280_sampler_run(&sampler);
+
+    host_start = stream_now_ns();
+    start = bme280_sim_now_usec();
+    end = start + seconds*1000000ULL;
+    for (i = 0; i < STREAM_SENSORS; i++) {
+        last_conversions[i] = sims[i].conversions;
+        bytes -= sims[i].bus_bytes;
+    }
+    for (deadline = start + poll_period; deadline < end; deadline += poll_period) {
+        now = bme280_sim_now_usec();
+        if (now < deadline) {
+            bme280_sim_advance_usec(deadline - now);
+        }
+
+        bme280_sampler_run(&sampler);
+        passes++;
+        for (i = 0; i < sampler.sensor_count; i++) {
+            struct bme280_sampler_sensor_t *sensor = &sampler.sensors[i];
+
+            if (sensor->result != SUCCESS) {
+                continue;
+            }
+            //the conversion count of the simulation tells whether the sampler was right
+            is_new = (sims[i].conversions != last_conversions[i]);
+            if (is_new) {
+                missed += sims[i].conversions - last_conversions[i] - 1;
+            }
+            last_conversions[i] = sims[i].conversions;
+            if (sensor->is_repeated) {
+                repeated++;
+                wrong_drops += is_new;
+                continue;
+            }
+            undetected += !is_new;
+
+            values = bme280_compensate_all_int32(sensor->device, sensor->uncomp_pressure,
+                                                 sensor->uncomp_temperature, sensor->uncomp_humidity);
+            sample.timestamp_usec = deadline;
+            sample.sequence = samples++;
+            sample.temperature = values.temperature;
+            sample.pressure = values.pressure;
+            sample.humidity = values.humidity;
+            sample.sensor = sensor->device->dev_addr;
+            telemetry_queue_push(&queue, &sample);
+        }
+
+        //the transmit task drains the queue after every pass
+        while (telemetry_queue_pop(&queue, &sample) == 0) {
+            telemetry_batch_add(&batch, &sample, bme280_sim_now_usec());
+            telemetry_aggregate_add(&aggregate, &sample);
+        }
+    }
+    telemetry_batch_flush(&batch);
+    telemetry_aggregate_flush(&aggregate);
+    host_elapsed = stream_now_ns() - host_start;
+    for (i = 0; i < STREAM_SENSORS; i++) {
+        bytes += sims[i].bus_bytes;
+    }
+
+    printf("%u s of %u sensors in normal mode, output period %u us (%.1f Hz), polled every %u us\n", seconds,
+           STREAM_SENSORS, period, 1e6/period, poll_period);
+    printf("samples: %.1f unique per second, %u repeated frames dropped, %u of them new conversions, "
+           "%u repeats not detected, %u conversions missed, %u dropped by the queue\n",
+           (double)samples/seconds, repeated, wrong_drops, undetected, missed, telemetry_queue_dropped(&queue));
+    printf("bus: %.1f bytes per pass, %.1f %% busy at %u kHz\n", (double)bytes/passes,
+           (bytes*9.0*100.0)/((double)seconds*STREAM_BUS_HZ), STREAM_BUS_HZ/1000);
+    printf("network: %u datagrams, %.1f per second, %.2f bytes per sample, %.0f bytes per second\n",
+           batch.datagrams, (double)batch.datagrams/seconds, (double)link.bytes/samples, (double)link.bytes/seconds);
+    if (link.fd < 0) {
+        printf("decoded %u of %u samples, %u errors\n", link.decoded, samples, link.errors);
+    }
+    else {
+        printf("sent to %s:%s, %u errors\n", argv[2], argv[3], link.errors);
+        close(link.fd);
+    }
+    printf("summaries: %u of %u s windows, %u samples, %.1f bytes per second, %.0fx less than the stream, %u errors\n",
+           summaries.summaries, STREAM_WINDOW_USEC/1000000, summaries.samples, (double)summaries.bytes/seconds,
+           (double)link.bytes/summaries.bytes, summaries.errors);
+    printf("host time per sample: %.0f ns, %.0fx real time\n", host_elapsed/samples,
+           (seconds*1e9)/host_elapsed);
+
+    return ((link.errors == 0) && ((link.fd >= 0) || (link.decoded == samples)) &&
+            (summaries.errors == 0) && (summaries.samples == samples) &&
+            (wrong_drops == 0) && (undetected == 0) && (missed == 0)) ? 0 : 1;
+}
@@ -7,18 +7,64 @@
    CONDITIONS OF ANY KIND, either express or implied.
 */
 #include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "driver/gpio.h"
 #include "driver/i2c.h"
+#include "rom/ets_sys.h"
+#include "esp_attr.h"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "soc/soc.h"
 
 #include "lwip/err.h"
 #include "lwip/udp.h"
 
+#include "i2c_bus.h"
 #include "wifi_smart.h"
 #include "bme280.h"
+#include "bme280_cache.h"
+#include "bme280_sampler.h"
+#include "telemetry.h"
+#include "telemetry_aggregate.h"
+#include "telemetry_batch.h"
+#include "telemetry_queue.h"
+#include "telemetry_ring.h"
+#include "telemetry_stats.h"
+#include "telemetry_wire.h"
+
+#define UDP_PORT 16901
+#define UDP_JSON_MAX_LENGTH 80
+
+#ifdef CONFIG_NODE_WIRE_DELTA
+#define NODE_BATCH_FORMAT TELEMETRY_BATCH_DELTA
+#else
+#define NODE_BATCH_FORMAT TELEMETRY_BATCH_RECORDS
+#endif
+
+#ifdef CONFIG_NODE_SAMPLING_DEEP_SLEEP
+//kept in RTC slow memory through deep sleep, loaded from the image on a cold boot
+#define NODE_RETAINED RTC_DATA_ATTR
+#define NODE_SLEEP_MAGIC 0x42533238
+#else
+#define NODE_RETAINED
+#endif
+
+//Wi-Fi and lwIP run on PRO_CPU, by default the sampler and the I2C bus have APP_CPU to themselves
+#if defined(CONFIG_NODE_SAMPLER_CORE_PRO)
+#define NODE_SAMPLER_CORE PRO_CPU_NUM
+#elif defined(CONFIG_NODE_SAMPLER_CORE_ANY) || defined(CONFIG_FREERTOS_UNICORE)
+#define NODE_SAMPLER_CORE tskNO_AFFINITY
+#else
+#define NODE_SAMPLER_CORE APP_CPU_NUM
+#endif
+#define NODE_NETWORK_CORE PRO_CPU_NUM
 
 static const char *debug_tag = "UDP";
 
@@ -31,146 +77,607 @@ static void i2c_master_init() {
         .scl_pullup_en = GPIO_PULLUP_ENABLE,
         .master.clk_speed = 1000000
     };
-    i2c_param_config(I2C_NUM_0, &i2c_config);
-    i2c_driver_install(I2C_NUM_0, I2C_MODE_MASTER, 0, 0, 0);
+    i2c_bus_init(I2C_NUM_0, &i2c_config, (CONFIG_NODE_SAMPLER_PRIORITY + 1), NODE_SAMPLER_CORE);
 }
 
 static int8_t bme280_i2c_write(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t date_length) {
-	esp_err_t error;
-        
-	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    if (i2c_bus_write(device_address, register_address, data, date_length) == ESP_OK) {
+        return (int8_t)SUCCESS;
+    } else {
+        return (int8_t)FAIL;
+    }
+}
+
+static int8_t bme280_i2c_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t date_length) {
+    if (i2c_bus_read(device_address, register_address, data, date_length) == ESP_OK) {
+        return (int8_t)SUCCESS;
+    } else {
+        return (int8_t)FAIL;
+    }
+}
+
+static void bme280_delay_usec(uint32_t delay) {//delay microseconds
+    int64_t deadline = esp_timer_get_time() + delay;
+    int64_t now;
+    uint32_t ticks = delay/(portTICK_PERIOD_MS*1000);
 
-	i2c_master_start(cmd);
-	i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_WRITE, true);
+    //vTaskDelay() wakes on the n-th tick interrupt, between n-1 and n ticks from now,
+    //so it never overruns the deadline; the rest up to a tick is busy waited
+    if (ticks > 0) {
+        vTaskDelay(ticks);
+    }
+    now = esp_timer_get_time();
+    if (now < deadline) {
+        ets_delay_us(deadline - now);
+    }
+}
 
-	i2c_master_write_byte(cmd, register_address, true);
-	i2c_master_write(cmd, data, date_length, true);
-	i2c_master_stop(cmd);
+static void bme280_delay(uint32_t delay) {//delay milliseconds
+    bme280_delay_usec(delay*1000);
+}
 
-	error = i2c_master_cmd_begin(I2C_NUM_0, cmd, (10/portTICK_PERIOD_MS));
-	i2c_cmd_link_delete(cmd);
-        
-        if (error == ESP_OK) {
-		return (int8_t)SUCCESS;
-	} else {
-		return (int8_t)FAIL;
-	}
+static uint32_t bme280_now_usec(void) {
+    return (uint32_t)esp_timer_get_time();
 }
 
-static int8_t bme280_i2c_read(uint8_t device_address, uint8_t register_address, uint8_t *data, uint8_t date_length) {
-    esp_err_t error;
+//calibration and shadow registers survive deep sleep with the sensors
+static NODE_RETAINED struct bme280_t bme280_devices[] = {
+    {
+        .bus_write = bme280_i2c_write,
+        .bus_read = bme280_i2c_read,
+        .dev_addr = BME280_I2C_ADDRESS1,
+        .delay_msec = bme280_delay,
+        .delay_usec = bme280_delay_usec,
+        .now_usec = bme280_now_usec,
+        .shadow_mode = BME280_SHADOW_MODE_ENABLE
+    },
+    {
+        .bus_write = bme280_i2c_write,
+        .bus_read = bme280_i2c_read,
+        .dev_addr = BME280_I2C_ADDRESS2,
+        .delay_msec = bme280_delay,
+        .delay_usec = bme280_delay_usec,
+        .now_usec = bme280_now_usec,
+        .shadow_mode = BME280_SHADOW_MODE_ENABLE
+    }
+};
+
+static NODE_RETAINED struct bme280_sampler_t bme280_sampler;
+static NODE_RETAINED uint32_t node_sequence = 0;
+static uint16_t node_id = CONFIG_NODE_ID;
+//frames read again before the sensor finished its next conversion
+static uint32_t node_repeated = 0;
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+#ifdef CONFIG_NODE_STREAMING
+//the output period of a sensor is only typical, reads come faster and repeated frames are dropped
+#define NODE_STREAM_POLL_PERCENT 75
 
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, register_address, true);
+//sensors convert on their own as fast as they can, the sampler only reads the data registers
+static const struct bme280_config_t bme280_config = {
+    .oversamp_temperature = BME280_OVERSAMP_1X,
+    .oversamp_pressure = BME280_OVERSAMP_1X,
+#ifdef CONFIG_NODE_STREAMING_HUMIDITY
+    .oversamp_humidity = BME280_OVERSAMP_1X,
+#else
+    .oversamp_humidity = BME280_OVERSAMP_SKIPPED,
+#endif
+    .power_mode = BME280_NORMAL_MODE,
+    .standby_durn = BME280_STANDBY_TIME_1_MS,
+    .filter = BME280_FILTER_COEFF_OFF
+};
+#else
+//sensors sleep between samples, the sampler triggers forced conversions
+static const struct bme280_config_t bme280_config = {
+    .oversamp_temperature = BME280_OVERSAMP_2X,
+    .oversamp_pressure = BME280_OVERSAMP_16X,
+    .oversamp_humidity = BME280_OVERSAMP_1X,
+    .power_mode = BME280_SLEEP_MODE,
+    .standby_durn = BME280_STANDBY_TIME_1_MS,
+    .filter = BME280_FILTER_COEFF_OFF
+};
+#endif
 
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_READ, true);
+static int32_t bme280_setup(struct bme280_t *bme280) {
+    int32_t result;
 
-    if (date_length > 1) {
-        i2c_master_read(cmd, data, (date_length-1), 0);
+    result = bme280_cache_init(bme280);
+    ESP_LOGI(debug_tag, "BME280(0x%02x) Init: %d", bme280->dev_addr, result);
+    if (result != SUCCESS) {
+        return result;
     }
-    i2c_master_read_byte(cmd, (data+(date_length-1)), 1);
-    i2c_master_stop(cmd);
+    result = bme280_apply_config(bme280, &bme280_config, BME280_CONFIG_VERIFY_ENABLE);
+    ESP_LOGI(debug_tag, "BME280(0x%02x) Apply Config: %d", bme280->dev_addr, result);
 
-    error = i2c_master_cmd_begin(I2C_NUM_0, cmd, (10/portTICK_PERIOD_MS));
-    i2c_cmd_link_delete(cmd);
+    return result;
+}
 
-    if (error == ESP_OK) {
-            return (int8_t)SUCCESS;
-    } else {
-            return (int8_t)FAIL;
+static void bme280_setup_all(void) {
+    uint8_t i;
+
+    //without the cache the calibration is read from the sensors
+    bme280_cache_open();
+    for (i = 0; i < (sizeof(bme280_devices)/sizeof(bme280_devices[0])); i++) {
+        if (bme280_setup(&bme280_devices[i]) == SUCCESS) {
+            bme280_sampler_add(&bme280_sampler, &bme280_devices[i], NULL, NULL, NULL);
+        }
     }
+    bme280_cache_close();
 }
 
-static void bme280_delay(uint32_t delay) {//delay milliseconds
-    vTaskDelay(delay/portTICK_PERIOD_MS);
+#ifdef CONFIG_NODE_SAMPLING_DEEP_SLEEP
+//RTC backed, keeps counting through deep sleep
+static uint64_t node_time_usec(void) {
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return ((uint64_t)now.tv_sec*1000000) + now.tv_usec;
+}
+#else
+//monotonic since boot, not moved by SNTP or settimeofday
+static uint64_t node_time_usec(void) {
+    return esp_timer_get_time();
 }
+#endif
 
-static void udp280_task(void *ignore) {
-    struct udp_pcb *local_pcb = udp_new();
-    struct udp_pcb *broadcast_pcb = udp_new();
-    int port = 16901;
-    char data[60] = "";
-    ip_addr_t bip;
-    
-    struct bme280_t bme280 = {
-        .bus_write = bme280_i2c_write,
-        .bus_read = bme280_i2c_read,
-        .dev_addr = BME280_I2C_ADDRESS1,
-        .delay_msec = bme280_delay
+//one sampling pass started at timestamp, returns the number of samples written
+static uint8_t node_sample(telemetry_sample_t samples[BME280_SAMPLER_MAX_SENSORS], uint64_t timestamp) {
+    struct bme280_compensated_int32_t values;
+    int32_t result;
+    uint8_t i, count = 0;
+
+    result = bme280_sampler_run(&bme280_sampler);
+    if (result != SUCCESS) {
+        ESP_LOGW(debug_tag, "Measure error: %d", result);
+    }
+
+    for (i = 0; i < bme280_sampler.sensor_count; i++) {
+        struct bme280_sampler_sensor_t *sensor = &bme280_sampler.sensors[i];
+        if (sensor->result != SUCCESS) {
+            continue;
+        }
+        if (sensor->is_repeated) {
+            node_repeated++;
+            continue;
+        }
+
+        values = bme280_compensate_all_int32(sensor->device, sensor->uncomp_pressure, sensor->uncomp_temperature, sensor->uncomp_humidity);
+        samples[count].timestamp_usec = timestamp;
+        samples[count].sequence = node_sequence++;
+        samples[count].temperature = values.temperature;
+        samples[count].pressure = values.pressure;
+        //a skipped humidity measurement leaves the reset value in its register
+        samples[count].humidity = (sensor->device->oversamp_humidity != BME280_OVERSAMP_SKIPPED) ? values.humidity : 0;
+        samples[count].sensor = sensor->device->dev_addr;
+        count++;
+    }
+
+    return count;
+}
+
+static void node_id_init(void) {
+    uint8_t mac[6];
+
+    if ((node_id == 0) && (esp_efuse_mac_get_default(mac) == ESP_OK)) {
+        node_id = (mac[4] << 8) | mac[5];
+    }
+}
+
+typedef struct {
+    struct udp_pcb *pcb;
+    ip_addr_t address;
+} node_link_t;
+
+//send callback of the batch, one datagram per call
+static void node_transmit(void *context, const uint8_t *data, size_t length) {
+    node_link_t *link = context;
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_RAM);
+
+    if (p == NULL) {
+        ESP_LOGW(debug_tag, "Failed to allocate datagram");
+        return;
+    }
+    memcpy(p->payload, data, length);
+    udp_sendto(link->pcb, p, &link->address, UDP_PORT);
+    pbuf_free(p);
+}
+
+//too big for the task stacks
+static telemetry_batch_t node_batch;
+
+#ifdef CONFIG_NODE_WIRE_JSON
+
+//debug mode, every sample goes out on its own
+static void node_send(const telemetry_sample_t *sample, uint64_t now) {
+    char data[UDP_JSON_MAX_LENGTH];
+    int length;
+
+    length = snprintf(data, sizeof(data), "{\"n\": %u, \"a\": %u, \"s\": %u, \"t\": %.2f, \"h\": %.3f, \"p\": %u}",
+                      node_id, sample->sensor, sample->sequence, sample->temperature/100.0f, sample->humidity/1024.0f, sample->pressure);
+    node_transmit(node_batch.context, (const uint8_t *)data, length);
+    ESP_LOGI(debug_tag, "Sensor: 0x%02x\nTemperature: %.2f\nHumidity: %.3f\nPressure: %.2f", sample->sensor,
+             sample->temperature/100.0f, sample->humidity/1024.0f, sample->pressure/100.0f);
+}
+
+#elif defined(CONFIG_NODE_AGGREGATE)
+
+static telemetry_aggregate_t node_aggregate;
+//summaries of the windows closed by one drain of the queue go out together
+static uint8_t node_summary_data[TELEMETRY_BATCH_MAX_LENGTH];
+static size_t node_summary_length = 0;
+
+static void node_summary_flush(void) {
+    if (node_summary_length > 0) {
+        node_transmit(node_batch.context, node_summary_data, node_summary_length);
+        node_summary_length = 0;
+    }
+}
+
+//emit callback of the aggregate, runs in the transmit task
+static void node_summary_add(void *ignore, const telemetry_summary_t *summary) {
+    if ((node_summary_length + TELEMETRY_WIRE_SUMMARY_SIZE) > sizeof(node_summary_data)) {
+        node_summary_flush();
+    }
+    node_summary_length += telemetry_wire_encode_summary(summary, node_id, &node_summary_data[node_summary_length],
+                                                         (sizeof(node_summary_data) - node_summary_length));
+    ESP_LOGD(debug_tag, "Sensor 0x%02x window of %u samples closed", summary->sensor, summary->temperature.count);
+}
+
+static void node_send(const telemetry_sample_t *sample, uint64_t now) {
+    telemetry_aggregate_add(&node_aggregate, sample);
+}
+
+#else
+
+//integers only, no soft float printf on the send path
+static void node_send(const telemetry_sample_t *sample, uint64_t now) {
+    telemetry_batch_add(&node_batch, sample, now);
+    ESP_LOGD(debug_tag, "Sensor 0x%02x sample %u queued", sample->sensor, sample->sequence);
+}
+
+#endif
+
+#ifdef CONFIG_NODE_SAMPLING_DEEP_SLEEP
+
+typedef struct {
+    uint32_t magic;
+    uint64_t next_sample_usec;
+    telemetry_ring_t ring;
+} node_sleep_state_t;
+
+//RTC_DATA_ATTR is loaded from the image again on every reset that isn't a deep sleep
+//wakeup, noinit RTC memory keeps the pending samples through watchdog and software
+//resets too. It holds garbage after power loss, the ring checks what it finds
+static RTC_NOINIT_ATTR node_sleep_state_t node_sleep_state;
+static RTC_NOINIT_ATTR telemetry_ring_entry_t node_sleep_entries[CONFIG_NODE_SLEEP_RING_CAPACITY];
+
+//8 kB of RTC slow memory, the rest is left to the IDF
+_Static_assert((sizeof(node_sleep_state) + sizeof(node_sleep_entries) + sizeof(bme280_devices) + sizeof(bme280_sampler)) <= 6144,
+               "retained state too big for RTC slow memory, lower CONFIG_NODE_SLEEP_RING_CAPACITY");
+static SemaphoreHandle_t node_sleep_sent;
+
+static void node_sleep_start(void) {
+    uint64_t now = node_time_usec();
+
+    //deadlines are absolute, the time spent awake is not added to the period
+    node_sleep_state.next_sample_usec += CONFIG_NODE_SAMPLE_PERIOD_MS*1000ULL;
+    if (node_sleep_state.next_sample_usec <= now) {
+        node_sleep_state.next_sample_usec = now + CONFIG_NODE_SAMPLE_PERIOD_MS*1000ULL;
+    }
+    esp_sleep_enable_timer_wakeup(node_sleep_state.next_sample_usec - now);
+    esp_deep_sleep_start();
+}
+
+static uint8_t node_sleep_is_batch_due(void) {
+    telemetry_sample_t oldest;
+
+    if (telemetry_ring_count(&node_sleep_state.ring) >= CONFIG_NODE_SLEEP_BATCH_SIZE) {
+        return 1;
+    }
+    //a corrupt oldest entry has no age, it goes out with the rest
+    if (telemetry_ring_peek(&node_sleep_state.ring, 0, &oldest) != 0) {
+        return (telemetry_ring_count(&node_sleep_state.ring) > 0);
+    }
+    return ((node_time_usec() - oldest.timestamp_usec) >= (CONFIG_NODE_SLEEP_BATCH_MAX_AGE_S*1000000ULL));
+}
+
+static void node_sleep_send_task(void *ignore) {
+    node_link_t link = {
+        .pcb = udp_new()
     };
+    telemetry_sample_t sample;
+    uint16_t i, count = telemetry_ring_count(&node_sleep_state.ring);
 
-    int32_t result;
-    int32_t raw_humidity;
-    int32_t raw_pressure;
-    int32_t raw_temperature;
-
-    result = bme280_init(&bme280);
-    ESP_LOGI(debug_tag, "BME280 Init: %d", result);
-    result += bme280_set_oversamp_humidity(BME280_OVERSAMP_1X);
-    ESP_LOGI(debug_tag, "BME280 Set Over Sampling for Humidity: %d", result);
-    result += bme280_set_oversamp_pressure(BME280_OVERSAMP_16X);
-    ESP_LOGI(debug_tag, "BME280 Set Over Sampling for Pressure: %d", result);
-    result += bme280_set_oversamp_temperature(BME280_OVERSAMP_2X);
-    ESP_LOGI(debug_tag, "BME280 Set Over Sampling for Temperature: %d", result);
-
-    result += bme280_set_standby_durn(BME280_STANDBY_TIME_1_MS);
-    ESP_LOGI(debug_tag, "BME280 Standby: %d", result);
-    result += bme280_set_filter(BME280_FILTER_COEFF_16);
-    ESP_LOGI(debug_tag, "BME280 Filter: %d", result);
-
-    result += bme280_set_power_mode(BME280_NORMAL_MODE);
-    ESP_LOGI(debug_tag, "BME280 Set Power Mode: %d", result);
-    
-    if (result == SUCCESS) {
-        udp_bind(local_pcb, IP_ADDR_ANY, port);
-        IP_ADDR4(&bip, 192, 168, 1, 255);
-
-        struct pbuf * p = pbuf_alloc(PBUF_TRANSPORT, 60, PBUF_REF);
-        double h = 0, pressure = 0, t = 0;
-        
-        while(true) {
-            vTaskDelay(100/portTICK_PERIOD_MS);
-            result = bme280_read_uncomp_pressure_temperature_humidity(&raw_pressure, &raw_temperature, &raw_humidity);
-
-            if (result == SUCCESS) {
-                h = bme280_compensate_humidity_double(raw_humidity);
-                pressure = bme280_compensate_pressure_double(raw_pressure);
-                t = bme280_compensate_temperature_double(raw_temperature);
-                
-                sprintf(data, "{\"t\": %.2f, \"h\": %.3f, \"p\": %.3f}", t, h, pressure);
-                p->payload = data;
-                udp_sendto(broadcast_pcb, p, &bip, port);
-                ESP_LOGI(debug_tag, "Sending data...");
-                ESP_LOGI(debug_tag, "Temperature: %.2f\nHumidity: %.3f\nPressure: %.3f", t, h, (pressure/100));
+    IP_ADDR4(&link.address, 192, 168, 1, 255);
+    //the whole ring goes out now, the age limit has no use here
+    telemetry_batch_init(&node_batch, node_id, NODE_BATCH_FORMAT, CONFIG_NODE_BATCH_SIZE, 0, node_transmit, &link);
+    for (i = 0; i < count; i++) {
+        if (telemetry_ring_peek(&node_sleep_state.ring, i, &sample) != 0) {
+            ESP_LOGW(debug_tag, "Pending sample %u is corrupt", i);
+            continue;
+        }
+        node_send(&sample, 0);
+    }
+    telemetry_batch_flush(&node_batch);
+    telemetry_ring_consume(&node_sleep_state.ring, count);
+    ESP_LOGI(debug_tag, "%u pending samples sent", count);
+    //datagrams are queued, give the driver time to put them on air
+    vTaskDelay(100/portTICK_PERIOD_MS);
+    udp_remove(link.pcb);
+
+    xSemaphoreGive(node_sleep_sent);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t node_sleep_connected(void) {
+    xTaskCreatePinnedToCore(&node_sleep_send_task, "node_sleep_send_task", 2048, NULL, 6, NULL, NODE_NETWORK_CORE);
+    return ESP_OK;
+}
+
+static void node_sleep_run(void) {
+    telemetry_sample_t samples[BME280_SAMPLER_MAX_SENSORS];
+    uint8_t i, count;
+
+    if (!telemetry_ring_attach(&node_sleep_state.ring, node_sleep_entries, CONFIG_NODE_SLEEP_RING_CAPACITY)) {
+        ESP_LOGI(debug_tag, "Pending samples reset");
+    }
+    if ((esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER) || (node_sleep_state.magic != NODE_SLEEP_MAGIC)) {
+        //cold boot, the retained state is the one of the image
+        bme280_setup_all();
+        if (bme280_sampler.sensor_count == 0) {
+            ESP_LOGE(debug_tag, "Error: no BME280 sensor found");
+        }
+        node_sleep_state.magic = NODE_SLEEP_MAGIC;
+        node_sleep_state.next_sample_usec = node_time_usec();
+    }
+
+    count = node_sample(samples, node_time_usec());
+    for (i = 0; i < count; i++) {
+        telemetry_ring_push(&node_sleep_state.ring, &samples[i]);
+    }
+
+    if (node_sleep_is_batch_due()) {
+        node_sleep_sent = xSemaphoreCreateBinary();
+        wifi_smart_init(node_sleep_connected);
+        if (xSemaphoreTake(node_sleep_sent, CONFIG_NODE_WIFI_TIMEOUT_MS/portTICK_PERIOD_MS) != pdTRUE) {
+            ESP_LOGW(debug_tag, "Batch of %u samples not sent, Wi-Fi timeout", telemetry_ring_count(&node_sleep_state.ring));
+        }
+    }
+
+    node_sleep_start();
+}
+
+#else
+
+#ifdef CONFIG_NODE_QUEUE_BLOCK
+#define NODE_QUEUE_POLICY TELEMETRY_QUEUE_BLOCK
+#else
+#define NODE_QUEUE_POLICY TELEMETRY_QUEUE_DROP_OLDEST
+#endif
+
+#if (CONFIG_NODE_QUEUE_LENGTH & (CONFIG_NODE_QUEUE_LENGTH - 1)) != 0
+#error "CONFIG_NODE_QUEUE_LENGTH must be a power of two"
+#endif
+
+static telemetry_sample_t node_queue_entries[CONFIG_NODE_QUEUE_LENGTH];
+static telemetry_queue_t node_queue;
+static TaskHandle_t node_sampler_handle = NULL;
+static TaskHandle_t node_transmit_handle = NULL;
+
+static SemaphoreHandle_t node_sample_tick;
+static esp_timer_handle_t node_sample_timer;
+static uint32_t node_sample_period_usec = 0;
+
+//runs in the esp_timer task, the periodic timer keeps absolute deadlines
+static void node_sample_timer_fired(void *ignore) {
+    //a counting semaphore and not a task notification, those wake the sampler for queue space
+    xSemaphoreGive(node_sample_tick);
+}
+
+#ifdef CONFIG_NODE_JITTER_PLACEMENT_SWEEP
+static const BaseType_t node_sweep_cores[] = {APP_CPU_NUM, PRO_CPU_NUM, tskNO_AFFINITY};
+static const char *node_sweep_names[] = {"APP_CPU", "PRO_CPU", "any core"};
+static uint8_t node_sweep_placement = 0;
+//the sampler task of the next placement counts on from the deadline of the last one
+static uint64_t node_sweep_deadline;
+#endif
+
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+static void node_jitter_report(telemetry_stats_t *jitter, uint32_t *missed) {
+#ifdef CONFIG_NODE_JITTER_PLACEMENT_SWEEP
+    const char *placement = node_sweep_names[node_sweep_placement];
+#else
+    const char *placement = "configured core";
+#endif
+
+    ESP_LOGI(debug_tag, "Sampler on %s (now core %d), priority %d, lateness over %u passes: mean %.1f us, stddev %.1f us, min %.0f us, max %.0f us, %u deadlines missed, %u repeated frames dropped",
+             placement, xPortGetCoreID(), CONFIG_NODE_SAMPLER_PRIORITY, jitter->count, jitter->mean,
+             telemetry_stats_stddev(jitter), jitter->min, jitter->max, *missed, node_repeated);
+    telemetry_stats_reset(jitter);
+    *missed = 0;
+    node_repeated = 0;
+}
+#endif
+
+//never waits for the network, only for a full queue with the blocking policy
+static void node_sampler_task(void *start) {
+    telemetry_sample_t samples[BME280_SAMPLER_MAX_SENSORS];
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+    //double is emulated on the ESP32, the statistics only run when they are reported
+    telemetry_stats_t jitter;
+    uint64_t deadline = *(uint64_t *)start;
+    uint32_t missed = 0;
+#endif
+    uint64_t now;
+    uint8_t i, count;
+
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+    telemetry_stats_reset(&jitter);
+#endif
+
+    while(true) {
+        xSemaphoreTake(node_sample_tick, portMAX_DELAY);
+        now = node_time_usec();
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+        deadline += node_sample_period_usec;
+#endif
+        //deadlines that passed while the last pass ran are skipped, not made up
+        while (xSemaphoreTake(node_sample_tick, 0) == pdTRUE) {
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+            deadline += node_sample_period_usec;
+            missed++;
+#endif
+        }
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+        //how late the pass starts against its deadline
+        telemetry_stats_add(&jitter, (double)(int64_t)(now - deadline));
+#endif
+
+        count = node_sample(samples, now);
+        for (i = 0; i < count; i++) {
+            //the transmit task gives a notification for every sample it takes
+            while (telemetry_queue_push(&node_queue, &samples[i]) < 0) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
             }
-            else {
-                ESP_LOGW(debug_tag, "Measure error: %d", result);
+        }
+        if (node_transmit_handle != NULL) {
+            xTaskNotifyGive(node_transmit_handle);
+        }
+
+#if CONFIG_NODE_JITTER_REPORT_PASSES > 0
+        if (jitter.count >= CONFIG_NODE_JITTER_REPORT_PASSES) {
+            node_jitter_report(&jitter, &missed);
+#ifdef CONFIG_NODE_JITTER_PLACEMENT_SWEEP
+            //tasks keep their core for life, the next placement gets a task of its own
+            node_sweep_deadline = deadline;
+            i = node_sweep_placement;
+            node_sweep_placement = (i + 1) % (sizeof(node_sweep_cores)/sizeof(node_sweep_cores[0]));
+            if (xTaskCreatePinnedToCore(&node_sampler_task, "node_sampler_task", 2048, &node_sweep_deadline,
+                                        CONFIG_NODE_SAMPLER_PRIORITY, &node_sampler_handle,
+                                        node_sweep_cores[node_sweep_placement]) == pdPASS) {
+                vTaskDelete(NULL);
             }
-            
-            vTaskDelay(10000/portTICK_PERIOD_MS);
+            ESP_LOGW(debug_tag, "Failed to move the sampler to %s", node_sweep_names[node_sweep_placement]);
+            node_sweep_placement = i;
+#endif
         }
-        
-        pbuf_free(p);
+#endif
     }
-    else {
-        ESP_LOGE(debug_tag, "Error: %d", result);
+}
+
+static void udp280_task(void *ignore) {
+    struct udp_pcb *local_pcb = udp_new();
+    node_link_t link;
+    telemetry_sample_t sample;
+    uint32_t dropped = 0;
+    uint64_t now;
+
+    udp_bind(local_pcb, IP_ADDR_ANY, UDP_PORT);
+    link.pcb = udp_new();
+    IP_ADDR4(&link.address, 192, 168, 1, 255);
+    telemetry_batch_init(&node_batch, node_id, NODE_BATCH_FORMAT, CONFIG_NODE_BATCH_SIZE, CONFIG_NODE_BATCH_MAX_AGE_MS*1000ULL,
+                         node_transmit, &link);
+#ifdef CONFIG_NODE_AGGREGATE
+    telemetry_aggregate_init(&node_aggregate, CONFIG_NODE_AGGREGATE_WINDOW_S*1000000UL, node_summary_add, NULL);
+#endif
+
+    while(true) {
+        //whatever piled up while the last datagram was stuck goes out together
+        now = node_time_usec();
+        while (telemetry_queue_pop(&node_queue, &sample) == 0) {
+#ifdef CONFIG_NODE_QUEUE_BLOCK
+            xTaskNotifyGive(node_sampler_handle);
+#endif
+            node_send(&sample, now);
+        }
+#ifdef CONFIG_NODE_AGGREGATE
+        node_summary_flush();
+#else
+        telemetry_batch_poll(&node_batch, now);
+#endif
+
+        if (telemetry_queue_dropped(&node_queue) != dropped) {
+            dropped = telemetry_queue_dropped(&node_queue);
+            ESP_LOGW(debug_tag, "Sample queue full, %u samples dropped", dropped);
+        }
+
+        //waits only after the first drain: a sampler blocked on the queue filled before Wi-Fi sends no notification
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
-    
-    vTaskDelete(NULL);
 }
 
 static esp_err_t wifi_connected(void) {
-    xTaskCreate(&udp280_task, "udp280_task", 2048, NULL, 6, NULL);
+    //called again after every reconnect
+    if (node_transmit_handle == NULL) {
+        xTaskCreatePinnedToCore(&udp280_task, "udp280_task", 2048, NULL, 6, &node_transmit_handle, NODE_NETWORK_CORE);
+    }
     return ESP_OK;
 }
 
+static void node_continuous_run(void) {
+    esp_timer_create_args_t timer_args = {
+        .callback = node_sample_timer_fired,
+        .name = "node_sample"
+    };
+    //outlives this function, the sampler task reads it when it starts
+    static uint64_t start;
+    esp_err_t error;
+#ifdef CONFIG_NODE_STREAMING
+    uint32_t period;
+    uint8_t i;
+#endif
+
+    telemetry_queue_init(&node_queue, node_queue_entries, CONFIG_NODE_QUEUE_LENGTH, NODE_QUEUE_POLICY);
+
+    //sampling starts before Wi-Fi, until it is up the queue keeps the latest samples or,
+    //with NODE_QUEUE_BLOCK, holds the sampler at the first ones until the transmit task starts
+    bme280_setup_all();
+    if (bme280_sampler.sensor_count == 0) {
+        ESP_LOGE(debug_tag, "Error: no BME280 sensor found");
+        return;
+    }
+    node_sample_tick = xSemaphoreCreateCounting(UINT16_MAX, 0);
+    error = esp_timer_create(&timer_args, &node_sample_timer);
+    if ((node_sample_tick == NULL) || (error != ESP_OK)) {
+        ESP_LOGE(debug_tag, "Failed to create sample timer: %d", error);
+        return;
+    }
+#ifdef CONFIG_NODE_STREAMING
+    //reads come faster than the fastest sensor converts, none of its conversions is missed
+    for (i = 0; i < bme280_sampler.sensor_count; i++) {
+        bme280_compute_normal_mode_period_usec(bme280_sampler.sensors[i].device, &period);
+        if ((node_sample_period_usec == 0) || (period < node_sample_period_usec)) {
+            node_sample_period_usec = period;
+        }
+    }
+    node_sample_period_usec = (node_sample_period_usec*NODE_STREAM_POLL_PERCENT)/100;
+    ESP_LOGI(debug_tag, "Streaming, sensors read every %u us", node_sample_period_usec);
+#else
+    node_sample_period_usec = CONFIG_NODE_SAMPLE_PERIOD_US;
+#endif
+
+    //the first deadline is one period after the start, the sampler task counts on from it
+    start = node_time_usec();
+    esp_timer_start_periodic(node_sample_timer, node_sample_period_usec);
+#ifdef CONFIG_NODE_JITTER_PLACEMENT_SWEEP
+    xTaskCreatePinnedToCore(&node_sampler_task, "node_sampler_task", 2048, &start, CONFIG_NODE_SAMPLER_PRIORITY,
+                            &node_sampler_handle, node_sweep_cores[node_sweep_placement]);
+#else
+    xTaskCreatePinnedToCore(&node_sampler_task, "node_sampler_task", 2048, &start, CONFIG_NODE_SAMPLER_PRIORITY,
+                            &node_sampler_handle, NODE_SAMPLER_CORE);
+#endif
+
+    wifi_smart_init(wifi_connected);
+}
+
+#endif
+
 void app_main() {
+    node_id_init();
     i2c_master_init();
+#ifdef CONFIG_NODE_SAMPLING_DEEP_SLEEP
+    node_sleep_run();
+#else
     vTaskDelay(1000/portTICK_PERIOD_MS);
-    wifi_smart_init(wifi_connected);
-    
+    node_continuous_run();
+#endif
 }